@@ -33,6 +33,7 @@ MODULE_OBJS := \
 	quicktime.o \
 	random.o \
 	rational.o \
+	region.o \
 	rendermode.o \
 	sinewindows.o \
 	str.o \
@@ -0,0 +1,279 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/region.h"
+#include "common/algorithm.h"
+
+namespace Common {
+
+namespace {
+
+struct Span {
+	int16 left, right;
+	Span(int16 l, int16 r) : left(l), right(r) {}
+};
+
+/**
+ * Collect the horizontal spans of a banded rect list within [y0, y1).
+ * The band must not cross any top or bottom of the list, so every rect
+ * either covers it entirely or not at all. Bands must be requested top
+ * to bottom, @p cursor remembers where the previous one started.
+ */
+void getSpans(const Array<Rect> &rects, uint &cursor, int16 y0, int16 y1, Array<Span> &spans) {
+	spans.clear();
+
+	while (cursor < rects.size() && rects[cursor].bottom <= y0)
+		cursor++;
+
+	for (uint i = cursor; i < rects.size() && rects[i].top < y1; i++)
+		spans.push_back(Span(rects[i].left, rects[i].right));
+}
+
+void addSpan(Array<Span> &spans, int16 left, int16 right) {
+	if (!spans.empty() && spans.back().right == left)
+		spans.back().right = right;
+	else
+		spans.push_back(Span(left, right));
+}
+
+} // End of anonymous namespace
+
+Region::Region(const Rect &r) {
+	if (!r.isEmpty())
+		_rects.push_back(r);
+}
+
+Rect Region::getBounds() const {
+	if (_rects.empty())
+		return Rect();
+
+	// The first and last rects are in the topmost and bottommost bands
+	Rect bounds(_rects.front().left, _rects.front().top, _rects.front().right, _rects.back().bottom);
+	for (uint i = 1; i < _rects.size(); i++) {
+		bounds.left = MIN(bounds.left, _rects[i].left);
+		bounds.right = MAX(bounds.right, _rects[i].right);
+	}
+	return bounds;
+}
+
+uint32 Region::getArea() const {
+	uint32 area = 0;
+	for (uint i = 0; i < _rects.size(); i++)
+		area += _rects[i].width() * _rects[i].height();
+	return area;
+}
+
+bool Region::contains(int16 x, int16 y) const {
+	for (uint i = 0; i < _rects.size() && _rects[i].top <= y; i++) {
+		if (_rects[i].contains(x, y))
+			return true;
+	}
+	return false;
+}
+
+bool Region::contains(const Rect &r) const {
+	if (r.isEmpty())
+		return true;
+
+	Region rest(r);
+	rest.subtract(*this);
+	return rest.isEmpty();
+}
+
+bool Region::intersects(const Rect &r) const {
+	for (uint i = 0; i < _rects.size() && _rects[i].top < r.bottom; i++) {
+		if (_rects[i].intersects(r))
+			return true;
+	}
+	return false;
+}
+
+void Region::unite(const Rect &r) {
+	if (r.isEmpty())
+		return;
+
+	if (_rects.empty()) {
+		_rects.push_back(r);
+		return;
+	}
+
+	combine(Region(r), kOpUnion);
+}
+
+void Region::unite(const Region &r) {
+	if (r.isEmpty())
+		return;
+
+	if (_rects.empty()) {
+		_rects = r._rects;
+		return;
+	}
+
+	combine(r, kOpUnion);
+}
+
+void Region::subtract(const Rect &r) {
+	if (!intersects(r))
+		return;
+
+	combine(Region(r), kOpSubtract);
+}
+
+void Region::subtract(const Region &r) {
+	if (_rects.empty() || r.isEmpty())
+		return;
+
+	combine(r, kOpSubtract);
+}
+
+void Region::intersect(const Rect &r) {
+	if (r.isEmpty()) {
+		_rects.clear();
+		return;
+	}
+
+	combine(Region(r), kOpIntersect);
+}
+
+void Region::intersect(const Region &r) {
+	if (r.isEmpty()) {
+		_rects.clear();
+		return;
+	}
+
+	combine(r, kOpIntersect);
+}
+
+void Region::translate(int16 dx, int16 dy) {
+	for (uint i = 0; i < _rects.size(); i++)
+		_rects[i].translate(dx, dy);
+}
+
+bool Region::operator==(const Region &r) const {
+	if (_rects.size() != r._rects.size())
+		return false;
+
+	for (uint i = 0; i < _rects.size(); i++) {
+		if (_rects[i] != r._rects[i])
+			return false;
+	}
+	return true;
+}
+
+void Region::combine(const Region &other, Op op) {
+	// Every top and bottom of both regions, a band never crosses any of them
+	Array<int16> ys;
+	ys.reserve((_rects.size() + other._rects.size()) * 2);
+	for (uint i = 0; i < _rects.size(); i++) {
+		ys.push_back(_rects[i].top);
+		ys.push_back(_rects[i].bottom);
+	}
+	for (uint i = 0; i < other._rects.size(); i++) {
+		ys.push_back(other._rects[i].top);
+		ys.push_back(other._rects[i].bottom);
+	}
+	sort(ys.begin(), ys.end());
+
+	Array<Rect> result;
+	Array<Span> spansA, spansB, spansOut;
+	Array<int16> xs;
+	uint cursorA = 0, cursorB = 0;
+	uint prevBandStart = 0, prevBandSize = 0;
+
+	for (uint yi = 0; yi + 1 < ys.size(); yi++) {
+		int16 y0 = ys[yi];
+		int16 y1 = ys[yi + 1];
+		if (y0 == y1)
+			continue;
+
+		getSpans(_rects, cursorA, y0, y1, spansA);
+		getSpans(other._rects, cursorB, y0, y1, spansB);
+
+		// Walk the span edges of both sides and keep what the op selects
+		xs.clear();
+		for (uint i = 0; i < spansA.size(); i++) {
+			xs.push_back(spansA[i].left);
+			xs.push_back(spansA[i].right);
+		}
+		for (uint i = 0; i < spansB.size(); i++) {
+			xs.push_back(spansB[i].left);
+			xs.push_back(spansB[i].right);
+		}
+		sort(xs.begin(), xs.end());
+
+		spansOut.clear();
+		uint ia = 0, ib = 0;
+		for (uint xi = 0; xi + 1 < xs.size(); xi++) {
+			int16 x0 = xs[xi];
+			int16 x1 = xs[xi + 1];
+			if (x0 == x1)
+				continue;
+
+			while (ia < spansA.size() && spansA[ia].right <= x0)
+				ia++;
+			while (ib < spansB.size() && spansB[ib].right <= x0)
+				ib++;
+			bool inA = ia < spansA.size() && spansA[ia].left <= x0;
+			bool inB = ib < spansB.size() && spansB[ib].left <= x0;
+
+			bool keep;
+			switch (op) {
+			case kOpUnion:
+				keep = inA || inB;
+				break;
+			case kOpSubtract:
+				keep = inA && !inB;
+				break;
+			case kOpIntersect:
+			default:
+				keep = inA && inB;
+				break;
+			}
+
+			if (keep)
+				addSpan(spansOut, x0, x1);
+		}
+
+		if (spansOut.empty())
+			continue;
+
+		// Grow the previous band instead if it has the same spans and touches this one
+		bool coalesce = prevBandSize == spansOut.size() && result[prevBandStart].bottom == y0;
+		for (uint i = 0; coalesce && i < spansOut.size(); i++) {
+			const Rect &prev = result[prevBandStart + i];
+			coalesce = prev.left == spansOut[i].left && prev.right == spansOut[i].right;
+		}
+
+		if (coalesce) {
+			for (uint i = 0; i < prevBandSize; i++)
+				result[prevBandStart + i].bottom = y1;
+		} else {
+			prevBandStart = result.size();
+			prevBandSize = spansOut.size();
+			for (uint i = 0; i < spansOut.size(); i++)
+				result.push_back(Rect(spansOut[i].left, y0, spansOut[i].right, y1));
+		}
+	}
+
+	_rects = result;
+}
+
+} // End of namespace Common
@@ -0,0 +1,101 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef COMMON_REGION_H
+#define COMMON_REGION_H
+
+#include "common/array.h"
+#include "common/rect.h"
+
+namespace Common {
+
+/**
+ * @defgroup common_region Regions
+ * @ingroup common
+ *
+ * @brief Sets of pixels made of rectangles.
+ *
+ * @{
+ */
+
+/**
+ * An arbitrary area stored as a list of non-overlapping rectangles.
+ *
+ * The rectangles are kept in y-x banded order: the area is cut into
+ * horizontal bands, all rectangles in a band share the same top and
+ * bottom, and they are sorted left to right. Vertically adjacent bands
+ * with the same horizontal spans are merged. Each pixel of the region
+ * is covered by exactly one rectangle, which makes the region suitable
+ * for dirty rectangle tracking where every pixel should be redrawn once.
+ */
+class Region {
+public:
+	typedef Array<Rect>::const_iterator const_iterator;
+
+	Region() {}
+	Region(const Rect &r);
+
+	bool isEmpty() const { return _rects.empty(); }
+	uint size() const { return _rects.size(); }
+	void clear() { _rects.clear(); }
+
+	const_iterator begin() const { return _rects.begin(); }
+	const_iterator end() const { return _rects.end(); }
+
+	/** Return the smallest rectangle containing the whole region. */
+	Rect getBounds() const;
+
+	/** Return the number of pixels covered by the region. */
+	uint32 getArea() const;
+
+	bool contains(int16 x, int16 y) const;
+	bool contains(const Rect &r) const;
+	bool intersects(const Rect &r) const;
+
+	void unite(const Rect &r);
+	void unite(const Region &r);
+	void subtract(const Rect &r);
+	void subtract(const Region &r);
+	void intersect(const Rect &r);
+	void intersect(const Region &r);
+
+	void translate(int16 dx, int16 dy);
+
+	bool operator==(const Region &r) const;
+	bool operator!=(const Region &r) const { return !(*this == r); }
+
+private:
+	enum Op {
+		kOpUnion,
+		kOpSubtract,
+		kOpIntersect
+	};
+
+	void combine(const Region &other, Op op);
+
+	Array<Rect> _rects;
+};
+
+/** @} */
+
+} // End of namespace Common
+
+#endif
@@ -719,7 +719,7 @@ int sort_out_walk_behinds(Bitmap *sprit, int xx, int yy, int basel, Bitmap *copy
 	        (!sprit->IsMemoryBitmap()))
 		quit("!sort_out_walk_behinds: wb bitmap not linear");
 
-	int rr, tmm, toheight; //,tcol;
+	int rr, toheight; //,tcol;
 	// precalculate this to try and shave some time off
 	int maskcol = sprit->GetMaskColor();
 	int spcoldep = sprit->GetColorDepth();
@@ -759,60 +759,62 @@ int sort_out_walk_behinds(Bitmap *sprit, int xx, int yy, int basel, Bitmap *copy
 			toheight = _G(walkBehindEndY)[ee + xx] - yy;
 		if (rr < 0)
 			rr = 0;
+		const int rowFrom = rr;
 
-		for (; rr < toheight; rr++) {
-
-			// we're ok with _getpixel because we've checked the screen edges
-			//tmm = _getpixel(_GP(thisroom).WalkBehindMask,ee+xx,rr+yy);
-			// actually, _getpixel is well inefficient, do it ourselves
-			// since we know it's 8-bit bitmap
-			tmm = _GP(thisroom).WalkBehindMask->GetScanLine(rr + yy)[ee + xx];
-			if (tmm < 1) continue;
-			if (_G(croom)->walkbehind_base[tmm] <= basel) continue;
-
-			if (copyPixelsFrom != nullptr) {
-				if (spcoldep <= 8) {
-					if (checkPixelsFrom->GetScanLine((rr * 100) / zoom)[(ee * 100) / zoom] != maskcol) {
-						sprit->GetScanLineForWriting(rr)[ee] = copyPixelsFrom->GetScanLine(rr + yy)[ee + xx];
-						pixelsChanged = 1;
-					}
-				} else if (spcoldep <= 16) {
-					shptr = (short *)&sprit->GetScanLine(rr)[0];
-					shptr2 = (short *)&checkPixelsFrom->GetScanLine((rr * 100) / zoom)[0];
-					if (shptr2[(ee * 100) / zoom] != maskcol) {
-						shptr[ee] = ((short *)(&copyPixelsFrom->GetScanLine(rr + yy)[0]))[ee + xx];
-						pixelsChanged = 1;
-					}
-				} else if (spcoldep == 24) {
-					char *chptr = (char *)&sprit->GetScanLine(rr)[0];
-					char *chptr2 = (char *)&checkPixelsFrom->GetScanLine((rr * 100) / zoom)[0];
-					if (memcmp(&chptr2[((ee * 100) / zoom) * 3], &maskcol, 3) != 0) {
-						memcpy(&chptr[ee * 3], &copyPixelsFrom->GetScanLine(rr + yy)[(ee + xx) * 3], 3);
-						pixelsChanged = 1;
-					}
-				} else if (spcoldep <= 32) {
-					loptr = (int *)&sprit->GetScanLine(rr)[0];
-					loptr2 = (int *)&checkPixelsFrom->GetScanLine((rr * 100) / zoom)[0];
-					if (loptr2[(ee * 100) / zoom] != maskcol) {
-						loptr[ee] = ((int *)(&copyPixelsFrom->GetScanLine(rr + yy)[0]))[ee + xx];
-						pixelsChanged = 1;
+		// Only visit the runs of walk-behind pixels which are in front of the sprite
+		const int *colRuns = &_G(walkBehindColumnRuns)[ee + xx];
+		for (int run = colRuns[0]; run < colRuns[1]; ++run) {
+			const WalkBehindColumnRun &wbRun = _G(walkBehindRuns)[run];
+			if (wbRun.Top - yy >= toheight)
+				break;
+			if (_G(croom)->walkbehind_base[wbRun.Area] <= basel)
+				continue;
+
+			for (rr = MAX(rowFrom, wbRun.Top - yy); rr < MIN(toheight, wbRun.Bottom - yy); rr++) {
+				if (copyPixelsFrom != nullptr) {
+					if (spcoldep <= 8) {
+						if (checkPixelsFrom->GetScanLine((rr * 100) / zoom)[(ee * 100) / zoom] != maskcol) {
+							sprit->GetScanLineForWriting(rr)[ee] = copyPixelsFrom->GetScanLine(rr + yy)[ee + xx];
+							pixelsChanged = 1;
+						}
+					} else if (spcoldep <= 16) {
+						shptr = (short *)&sprit->GetScanLine(rr)[0];
+						shptr2 = (short *)&checkPixelsFrom->GetScanLine((rr * 100) / zoom)[0];
+						if (shptr2[(ee * 100) / zoom] != maskcol) {
+							shptr[ee] = ((short *)(&copyPixelsFrom->GetScanLine(rr + yy)[0]))[ee + xx];
+							pixelsChanged = 1;
+						}
+					} else if (spcoldep == 24) {
+						char *chptr = (char *)&sprit->GetScanLine(rr)[0];
+						char *chptr2 = (char *)&checkPixelsFrom->GetScanLine((rr * 100) / zoom)[0];
+						if (memcmp(&chptr2[((ee * 100) / zoom) * 3], &maskcol, 3) != 0) {
+							memcpy(&chptr[ee * 3], &copyPixelsFrom->GetScanLine(rr + yy)[(ee + xx) * 3], 3);
+							pixelsChanged = 1;
+						}
+					} else if (spcoldep <= 32) {
+						loptr = (int *)&sprit->GetScanLine(rr)[0];
+						loptr2 = (int *)&checkPixelsFrom->GetScanLine((rr * 100) / zoom)[0];
+						if (loptr2[(ee * 100) / zoom] != maskcol) {
+							loptr[ee] = ((int *)(&copyPixelsFrom->GetScanLine(rr + yy)[0]))[ee + xx];
+							pixelsChanged = 1;
+						}
 					}
+				} else {
+					pixelsChanged = 1;
+					if (spcoldep <= 8)
+						sprit->GetScanLineForWriting(rr)[ee] = maskcol;
+					else if (spcoldep <= 16) {
+						shptr = (short *)&sprit->GetScanLine(rr)[0];
+						shptr[ee] = maskcol;
+					} else if (spcoldep == 24) {
+						char *chptr = (char *)&sprit->GetScanLine(rr)[0];
+						memcpy(&chptr[ee * 3], &maskcol, 3);
+					} else if (spcoldep <= 32) {
+						loptr = (int *)&sprit->GetScanLine(rr)[0];
+						loptr[ee] = maskcol;
+					} else
+						quit("!Sprite colour depth >32 ??");
 				}
-			} else {
-				pixelsChanged = 1;
-				if (spcoldep <= 8)
-					sprit->GetScanLineForWriting(rr)[ee] = maskcol;
-				else if (spcoldep <= 16) {
-					shptr = (short *)&sprit->GetScanLine(rr)[0];
-					shptr[ee] = maskcol;
-				} else if (spcoldep == 24) {
-					char *chptr = (char *)&sprit->GetScanLine(rr)[0];
-					memcpy(&chptr[ee * 3], &maskcol, 3);
-				} else if (spcoldep <= 32) {
-					loptr = (int *)&sprit->GetScanLine(rr)[0];
-					loptr[ee] = maskcol;
-				} else
-					quit("!Sprite colour depth >32 ??");
 			}
 		}
 	}
@@ -1785,7 +1787,12 @@ void prepare_room_sprites() {
 void draw_preroom_background() {
 	if (_G(gfxDriver)->RequiresFullRedrawEachFrame())
 		return;
-	update_black_invreg_and_reset(_G(gfxDriver)->GetMemoryBackBuffer());
+	// Only the painted regions are passed to the driver as dirty, so that
+	// it does not have to present the whole screen
+	std::vector<Rect> painted;
+	update_black_invreg_and_reset(_G(gfxDriver)->GetStageBackBuffer(false), &painted);
+	for (const auto &rc : painted)
+		_G(gfxDriver)->MarkStageDirtyRect(rc);
 }
 
 // Draws the room background on the given surface.
@@ -1805,7 +1812,7 @@ PBitmap draw_room_background(Viewport *view, const SpriteTransform &room_trans)
 	// 32-bit virtual screen).
 	// Also see comment to ALSoftwareGraphicsDriver::RenderToBackBuffer().
 	const int view_index = view->GetID();
-	Bitmap *ds = _G(gfxDriver)->GetMemoryBackBuffer();
+	Bitmap *ds = _G(gfxDriver)->GetStageBackBuffer(false);
 	// If separate bitmap was prepared for this view/camera pair then use it, draw untransformed
 	// and blit transformed whole surface later.
 	const bool draw_to_camsurf = _GP(CameraDrawData)[view_index].Frame != nullptr;
@@ -1822,7 +1829,13 @@ PBitmap draw_room_background(Viewport *view, const SpriteTransform &room_trans)
 		// the following line takes up to 50% of the game CPU time at
 		// high resolutions and colour depths - if we can optimise it
 		// somehow, significant performance gains to be had
-		update_room_invreg_and_reset(view_index, roomcam_surface, _GP(thisroom).BgFrames[_GP(play).bg_frame].Graphic.get(), draw_to_camsurf);
+		// A separate camera surface is passed to the driver as a whole, otherwise
+		// it is told which regions of the back buffer were restored
+		std::vector<Rect> painted;
+		update_room_invreg_and_reset(view_index, roomcam_surface, _GP(thisroom).BgFrames[_GP(play).bg_frame].Graphic.get(), draw_to_camsurf,
+			draw_to_camsurf ? nullptr : &painted);
+		for (const auto &rc : painted)
+			_G(gfxDriver)->MarkStageDirtyRect(rc);
 	}
 
 	return _GP(CameraDrawData)[view_index].Frame;
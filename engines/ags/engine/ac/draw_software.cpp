@@ -303,12 +303,25 @@ void invalidate_rect_global(int x1, int y1, int x2, int y2) {
 		invalidate_rect_ds(rects, x1, y1, x2, y2, false);
 }
 
+// Adds a painted rect to the list, joining it with a rect that ends on the row
+// right above it and overlaps it horizontally, so that the spans of one area
+// on consecutive rows make up a single rect
+static void add_painted_rect(std::vector<Rect> &painted, const Rect &r) {
+	for (auto &p : painted) {
+		if (p.Bottom + 1 == r.Top && p.Left <= r.Right && p.Right >= r.Left) {
+			p = Rect(MIN(p.Left, r.Left), p.Top, MAX(p.Right, r.Right), r.Bottom);
+			return;
+		}
+	}
+	painted.push_back(r);
+}
+
 // Note that this function is denied to perform any kind of scaling or other transformation
 // other than blitting with offset. This is mainly because destination could be a 32-bit virtual screen
 // while room background was 16-bit and Allegro lib does not support stretching between colour depths.
 // The no_transform flag here means essentially "no offset", and indicates that the function
 // must blit src on ds at 0;0. Otherwise, actual Viewport offset is used.
-void update_invalid_region(Bitmap *ds, Bitmap *src, const DirtyRects &rects, bool no_transform) {
+void update_invalid_region(Bitmap *ds, Bitmap *src, const DirtyRects &rects, bool no_transform, std::vector<Rect> *painted) {
 	if (rects.NumDirtyRegions == 0)
 		return;
 
@@ -322,6 +335,8 @@ void update_invalid_region(Bitmap *ds, Bitmap *src, const DirtyRects &rects, boo
 
 	if (rects.NumDirtyRegions == WHOLESCREENDIRTY) {
 		ds->Blit(src, src_x, src_y, dst_x, dst_y, rects.SurfaceSize.Width, rects.SurfaceSize.Height);
+		if (painted)
+			painted->push_back(RectWH(dst_x, dst_y, rects.SurfaceSize.Width, rects.SurfaceSize.Height));
 	} else {
 		const std::vector<IRRow> &dirtyRow = rects.DirtyRows;
 		const int surf_height = rects.SurfaceSize.Height;
@@ -338,6 +353,8 @@ void update_invalid_region(Bitmap *ds, Bitmap *src, const DirtyRects &rects, boo
 					int tx1 = dirty_row.span[k].x1;
 					int tx2 = dirty_row.span[k].x2;
 					memcpy(&dst_scanline[(tx1 + dst_x) * bypp], &src_scanline[(tx1 + src_x) * bypp], ((tx2 - tx1) + 1) * bypp);
+					if (painted)
+						add_painted_rect(*painted, Rect(tx1 + dst_x, i + dst_y, tx2 + dst_x, i + dst_y));
 				}
 			}
 		}
@@ -355,17 +372,21 @@ void update_invalid_region(Bitmap *ds, Bitmap *src, const DirtyRects &rects, boo
 					int tx1 = dirty_row.span[k].x1;
 					int tx2 = dirty_row.span[k].x2;
 					ds->Blit(src, tx1 + src_x, i + src_y, tx1 + dst_x, i + dst_y, (tx2 - tx1) + 1, rowsInOne);
+					if (painted)
+						add_painted_rect(*painted, Rect(tx1 + dst_x, i + dst_y, tx2 + dst_x, i + dst_y + rowsInOne - 1));
 				}
 			}
 		}
 	}
 }
 
-void update_invalid_region(Bitmap *ds, color_t fill_color, const DirtyRects &rects) {
+void update_invalid_region(Bitmap *ds, color_t fill_color, const DirtyRects &rects, std::vector<Rect> *painted) {
 	ds->SetClip(rects.Viewport);
 
 	if (rects.NumDirtyRegions == WHOLESCREENDIRTY) {
 		ds->FillRect(rects.Viewport, fill_color);
+		if (painted)
+			painted->push_back(rects.Viewport);
 	} else {
 		const std::vector<IRRow> &dirtyRow = rects.DirtyRows;
 		const int surf_height = rects.SurfaceSize.Height;
@@ -382,24 +403,26 @@ void update_invalid_region(Bitmap *ds, color_t fill_color, const DirtyRects &rec
 					Rect src_r(dirty_row.span[k].x1, i, dirty_row.span[k].x2, i + rowsInOne - 1);
 					Rect dst_r = tf.ScaleRange(src_r);
 					ds->FillRect(dst_r, fill_color);
+					if (painted)
+						add_painted_rect(*painted, dst_r);
 				}
 			}
 		}
 	}
 }
 
-void update_black_invreg_and_reset(Bitmap *ds) {
+void update_black_invreg_and_reset(Bitmap *ds, std::vector<Rect> *painted) {
 	if (!_GP(BlackRects).IsInit())
 		return;
-	update_invalid_region(ds, (color_t)0, _GP(BlackRects));
+	update_invalid_region(ds, (color_t)0, _GP(BlackRects), painted);
 	_GP(BlackRects).Reset();
 }
 
-void update_room_invreg_and_reset(int view_index, Bitmap *ds, Bitmap *src, bool no_transform) {
+void update_room_invreg_and_reset(int view_index, Bitmap *ds, Bitmap *src, bool no_transform, std::vector<Rect> *painted) {
 	if (view_index < 0 || _GP(RoomCamRects).size() == 0)
 		return;
 
-	update_invalid_region(ds, src, _GP(RoomCamRects)[view_index], no_transform);
+	update_invalid_region(ds, src, _GP(RoomCamRects)[view_index], no_transform, painted);
 	_GP(RoomCamRects)[view_index].Reset();
 }
 
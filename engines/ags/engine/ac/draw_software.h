@@ -105,11 +105,14 @@ void invalidate_all_camera_rects(int view_index);
 void invalidate_rect_ds(int x1, int y1, int x2, int y2, bool in_room);
 // Mark rectangle dirty, treat pos as global screen coords (not offset by legacy letterbox mode)
 void invalidate_rect_global(int x1, int y1, int x2, int y2);
-// Paints the black screen background in the regions marked as dirty
-void update_black_invreg_and_reset(AGS::Shared::Bitmap *ds);
+// Paints the black screen background in the regions marked as dirty;
+// if painted is given, the screen rects that were painted over are added to it
+void update_black_invreg_and_reset(AGS::Shared::Bitmap *ds, std::vector<Rect> *painted = nullptr);
 // Copies the room regions marked as dirty from source (src) to destination (ds) with the given offset (x, y)
 // no_transform flag tells the system that the regions should be plain copied to the ds.
-void update_room_invreg_and_reset(int view_index, AGS::Shared::Bitmap *ds, AGS::Shared::Bitmap *src, bool no_transform);
+// If painted is given, the rects of ds that were copied to are added to it
+void update_room_invreg_and_reset(int view_index, AGS::Shared::Bitmap *ds, AGS::Shared::Bitmap *src, bool no_transform,
+	std::vector<Rect> *painted = nullptr);
 
 } // namespace AGS3
 
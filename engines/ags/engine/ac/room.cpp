@@ -66,6 +66,7 @@
 #include "ags/engine/script/script.h"
 #include "ags/engine/script/script_runtime.h"
 #include "ags/shared/ac/sprite_cache.h"
+#include "ags/shared/ac/view.h"
 #include "ags/shared/util/stream.h"
 #include "ags/engine/gfx/graphics_driver.h"
 #include "ags/shared/core/asset_manager.h"
@@ -433,6 +434,39 @@ HError LoadRoomScript(RoomStruct *room, int newnum) {
 	return HError::None();
 }
 
+// Loads the sprites of a view loop, as long as the sprite cache has room
+static void prefetch_view_loop_sprites(int view, int loop) {
+	if (view < 0 || view >= _GP(game).numviews)
+		return;
+	const ViewStruct &vw = _G(views)[view];
+	if (loop < 0 || loop >= vw.numLoops)
+		return;
+	for (int i = 0; i < vw.loops[loop].numFrames; ++i)
+		_GP(spriteset).PrefetchSprite(vw.loops[loop].frames[i].pic);
+}
+
+// Loads the sprites which are likely to be drawn right after entering the
+// room: the current images and animations of the room objects, and the
+// views of the characters present, so the first frames do not stall on
+// decompressing them
+static void prefetch_room_sprites() {
+	for (int i = 0; i < _G(croom)->numobj; ++i) {
+		const RoomObject &obj = _G(objs)[i];
+		if (!obj.on)
+			continue;
+		_GP(spriteset).PrefetchSprite(obj.num);
+		if (obj.view != (uint16_t)-1)
+			prefetch_view_loop_sprites(obj.view, obj.loop);
+	}
+	for (int i = 0; i < _GP(game).numcharacters; ++i) {
+		const CharacterInfo &chr = _GP(game).chars[i];
+		if (chr.room != _G(displayed_room) || !chr.on || chr.view < 0 || chr.view >= _GP(game).numviews)
+			continue;
+		for (int loop = 0; loop < _G(views)[chr.view].numLoops; ++loop)
+			prefetch_view_loop_sprites(chr.view, loop);
+	}
+}
+
 // forchar = playerchar on NewRoom, or NULL if restore saved game
 void load_new_room(int newnum, CharacterInfo *forchar) {
 
@@ -888,6 +922,7 @@ void load_new_room(int newnum, CharacterInfo *forchar) {
 		_GP(play).UpdateRoomCameras(); // update auto tracking
 	}
 	init_room_drawdata();
+	prefetch_room_sprites();
 
 	_G(our_eip) = 212;
 	invalidate_screen();
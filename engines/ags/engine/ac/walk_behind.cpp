@@ -96,12 +96,23 @@ void recache_walk_behinds() {
 
 	update_polled_stuff_if_runtime();
 
+	_G(walkBehindRuns).clear();
+	_G(walkBehindColumnRuns).resize(_GP(thisroom).WalkBehindMask->GetWidth() + 1);
 	for (ee = 0; ee < _GP(thisroom).WalkBehindMask->GetWidth(); ee++) {
 		_G(walkBehindExists)[ee] = 0;
+		_G(walkBehindColumnRuns)[ee] = _G(walkBehindRuns).size();
 		for (rr = 0; rr < _GP(thisroom).WalkBehindMask->GetHeight(); rr++) {
 			tmm = _GP(thisroom).WalkBehindMask->GetScanLine(rr)[ee];
 			//tmm = _getpixel(_GP(thisroom).WalkBehindMask,ee,rr);
 			if ((tmm >= 1) && (tmm < MAX_WALK_BEHINDS)) {
+				// Extend the column's last run, or start a new one
+				if (_G(walkBehindRuns).size() > (size_t)_G(walkBehindColumnRuns)[ee] &&
+					_G(walkBehindRuns).back().Bottom == rr && _G(walkBehindRuns).back().Area == tmm) {
+					_G(walkBehindRuns).back().Bottom = rr + 1;
+				} else {
+					WalkBehindColumnRun run = { rr, rr + 1, tmm };
+					_G(walkBehindRuns).push_back(run);
+				}
 				if (!_G(walkBehindExists)[ee]) {
 					_G(walkBehindStartY)[ee] = rr;
 					_G(walkBehindExists)[ee] = tmm;
@@ -116,6 +127,7 @@ void recache_walk_behinds() {
 			}
 		}
 	}
+	_G(walkBehindColumnRuns)[_GP(thisroom).WalkBehindMask->GetWidth()] = _G(walkBehindRuns).size();
 
 	if (_G(walkBehindMethod) == DrawAsSeparateSprite) {
 		update_walk_behind_images();
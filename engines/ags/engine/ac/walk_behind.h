@@ -40,6 +40,14 @@ enum WalkBehindMethodEnum {
 	DrawAsSeparateCharSprite
 };
 
+// A vertical run of walk-behind mask pixels belonging to the same area,
+// used to find the walk-behinds covering a sprite without scanning the mask
+struct WalkBehindColumnRun {
+	int Top;    // first row of the run
+	int Bottom; // row past the last one of the run
+	int Area;   // walk-behind area index
+};
+
 void update_walk_behind_images();
 void recache_walk_behinds();
 
@@ -40,6 +40,13 @@ using namespace Shared;
 
 static RGB faded_out_palette[256];
 
+// Beyond this number of separate dirty regions the whole frame is copied
+static const size_t MAX_DIRTY_RECTS = 32;
+
+static Rect IntersectRects(const Rect &r1, const Rect &r2) {
+	return Rect(MAX(r1.Left, r2.Left), MAX(r1.Top, r2.Top), MIN(r1.Right, r2.Right), MIN(r1.Bottom, r2.Bottom));
+}
+
 
 // ----------------------------------------------------------------------------
 // ScummVMRendererGraphicsDriver
@@ -141,7 +148,7 @@ void ScummVMRendererGraphicsDriver::CreateVirtualScreen() {
 	_origVirtualScreen.reset(new Bitmap(vscreen_w, vscreen_h, _srcColorDepth));
 	virtualScreen = _origVirtualScreen.get();
 	_stageVirtualScreen = virtualScreen;
-
+	MarkFullFrameDirty();
 
 	_lastTexPixels = nullptr;
 	_lastTexPitch = -1;
@@ -222,6 +229,12 @@ void ScummVMRendererGraphicsDriver::UpdateDDBFromBitmap(IDriverDependantBitmap *
 	ALSoftwareBitmap *alSwBmp = (ALSoftwareBitmap *)bitmapToUpdate;
 	alSwBmp->_bmp = bitmap;
 	alSwBmp->_hasAlpha = hasAlpha;
+	alSwBmp->_version = ++_ddbVersion;
+	// Bitmaps which were not rendered on the last frame may still be shown
+	// by other means (e.g. room background restored by the engine itself),
+	// so we cannot tell which part of the screen they affect
+	if (alSwBmp->_drawnFrame != _frameIndex)
+		MarkFullFrameDirty();
 }
 
 void ScummVMRendererGraphicsDriver::DestroyDDB(IDriverDependantBitmap *bitmap) {
@@ -303,11 +316,17 @@ void ScummVMRendererGraphicsDriver::RenderToBackBuffer() {
 	// that here would slow things down significantly, so if we ever go that way sprite caching will
 	// be required (similarily to how AGS caches flipped/scaled object sprites now for).
 	//
+	_frameIndex++;
+	if (_lastBatchCount != _actSpriteBatch + 1)
+		MarkFullFrameDirty();
+	_lastBatchCount = _actSpriteBatch + 1;
+
 	for (size_t i = 0; i <= _actSpriteBatch; ++i) {
 		const Rect &viewport = _spriteBatchDesc[i].Viewport;
 		const SpriteTransform &transform = _spriteBatchDesc[i].Transform;
-		const ALSpriteBatch &batch = _spriteBatches[i];
+		ALSpriteBatch &batch = _spriteBatches[i];
 
+		UpdateBatchDirtyRegions(batch, viewport, transform);
 		virtualScreen->SetClip(viewport);
 		Bitmap *surface = batch.Surface.get();
 		const int view_offx = viewport.Left;
@@ -328,6 +347,83 @@ void ScummVMRendererGraphicsDriver::RenderToBackBuffer() {
 	ClearDrawLists();
 }
 
+void ScummVMRendererGraphicsDriver::UpdateBatchDirtyRegions(ALSpriteBatch &batch, const Rect &viewport, const SpriteTransform &transform) {
+	const bool same_placement = batch.HasLastDrawn && batch.LastViewport == viewport &&
+		batch.LastSurface == batch.Surface.get() &&
+		batch.LastTransform.X == transform.X && batch.LastTransform.Y == transform.Y &&
+		batch.LastTransform.ScaleX == transform.ScaleX && batch.LastTransform.ScaleY == transform.ScaleY;
+	if (!same_placement)
+		MarkFullFrameDirty();
+	// A separate surface is stretched over the whole viewport each time
+	const bool separate_surface = batch.Surface && !batch.IsVirtualScreen;
+	if (separate_surface)
+		MarkDirtyRect(viewport);
+
+	const int offx = viewport.Left + transform.X;
+	const int offy = viewport.Top + transform.Y;
+	std::vector<ALDrawnSprite> drawn;
+	drawn.reserve(batch.List.size());
+	for (const auto &entry : batch.List) {
+		// Plugin callbacks and screen tint may paint anywhere on the screen
+		if (entry.bitmap == nullptr || entry.bitmap == (ALSoftwareBitmap *)0x1) {
+			MarkFullFrameDirty();
+			continue;
+		}
+		entry.bitmap->_drawnFrame = _frameIndex;
+		ALDrawnSprite sprite;
+		sprite.Ddb = entry.bitmap;
+		sprite.Version = entry.bitmap->_version;
+		sprite.Transparency = entry.bitmap->_transparency;
+		sprite.Area = RectWH(entry.x + offx, entry.y + offy, entry.bitmap->_bmp->GetWidth(), entry.bitmap->_bmp->GetHeight());
+		drawn.push_back(sprite);
+	}
+
+	if (!separate_surface) {
+		// Both the old and the new area of a changed sprite have to be updated
+		const std::vector<ALDrawnSprite> &last = batch.LastDrawn;
+		const size_t count = MAX(last.size(), drawn.size());
+		for (size_t i = 0; i < count && !_fullFrameDirty; ++i) {
+			if (i < last.size() && i < drawn.size() && last[i] == drawn[i])
+				continue;
+			if (i < last.size())
+				MarkDirtyRect(IntersectRects(viewport, last[i].Area));
+			if (i < drawn.size())
+				MarkDirtyRect(IntersectRects(viewport, drawn[i].Area));
+		}
+	}
+
+	batch.LastDrawn.swap(drawn);
+	batch.LastViewport = viewport;
+	batch.LastTransform = transform;
+	batch.LastSurface = batch.Surface.get();
+	batch.HasLastDrawn = true;
+}
+
+void ScummVMRendererGraphicsDriver::MarkDirtyRect(const Rect &rc) {
+	if (_fullFrameDirty || !virtualScreen)
+		return;
+	const Rect r = IntersectRects(RectWH(virtualScreen->GetSize()), rc);
+	if (r.IsEmpty())
+		return;
+	for (auto &dirty : _dirtyRects) {
+		if (AreRectsIntersecting(dirty, r)) {
+			dirty = Rect(MIN(dirty.Left, r.Left), MIN(dirty.Top, r.Top),
+			             MAX(dirty.Right, r.Right), MAX(dirty.Bottom, r.Bottom));
+			return;
+		}
+	}
+	if (_dirtyRects.size() >= MAX_DIRTY_RECTS) {
+		MarkFullFrameDirty();
+		return;
+	}
+	_dirtyRects.push_back(r);
+}
+
+void ScummVMRendererGraphicsDriver::MarkFullFrameDirty() {
+	_fullFrameDirty = true;
+	_dirtyRects.clear();
+}
+
 void ScummVMRendererGraphicsDriver::RenderSpriteBatch(const ALSpriteBatch &batch, Shared::Bitmap *surface, int surf_offx, int surf_offy) {
 	const std::vector<ALDrawListEntry> &drawlist = batch.List;
 	for (size_t i = 0; i < drawlist.size(); i++) {
@@ -373,15 +469,15 @@ void ScummVMRendererGraphicsDriver::RenderSpriteBatch(const ALSpriteBatch &batch
 	}
 }
 
-void ScummVMRendererGraphicsDriver::copySurface(const Graphics::Surface &src, bool mode) {
+void ScummVMRendererGraphicsDriver::copySurface(const Graphics::Surface &src, bool mode, const Common::Rect &area) {
 	assert(src.w == _screen->w && src.h == _screen->h && src.pitch == _screen->pitch);
-	const uint32 *srcP = (const uint32 *)src.getPixels();
-	uint32 *destP = (uint32 *)_screen->getPixels();
 	uint32 pixel;
 	int x1 = 9999, y1 = 9999, x2 = -1, y2 = -1;
 
-	for (int y = 0; y < src.h; ++y) {
-		for (int x = 0; x < src.w; ++x, ++srcP, ++destP) {
+	for (int y = area.top; y < area.bottom; ++y) {
+		const uint32 *srcP = (const uint32 *)src.getBasePtr(area.left, y);
+		uint32 *destP = (uint32 *)_screen->getBasePtr(area.left, y);
+		for (int x = area.left; x < area.right; ++x, ++srcP, ++destP) {
 			if (!mode) {
 				pixel = (*srcP & 0xff00ff00) |
 					((*srcP & 0xff) << 16) |
@@ -405,7 +501,7 @@ void ScummVMRendererGraphicsDriver::copySurface(const Graphics::Surface &src, bo
 		_screen->addDirtyRect(Common::Rect(x1, y1, x2 + 1, y2 + 1));
 }
 
-void ScummVMRendererGraphicsDriver::BlitToScreen() {
+void ScummVMRendererGraphicsDriver::BlitToScreen(bool dirty_only) {
 	const Graphics::Surface &src =
 		virtualScreen->GetAllegroBitmap()->getSurface();
 
@@ -436,39 +532,54 @@ void ScummVMRendererGraphicsDriver::BlitToScreen() {
 	if (renderMode != kRenderDirect && !_screen)
 		_screen = new Graphics::Screen();
 
-	switch (renderMode) {
-	case kRenderToABGR:
-		// ARGB to ABGR
-		copySurface(src, false);
-		break;
-
-	case kRenderToRGBA:
-		// ARGB to RGBA
-		copySurface(src, true);
-		break;
-
-	case kRenderOther: {
-		// Blit the surface to the temporary screen, ignoring the alphas.
-		// This takes care of converting to the screen format
-		Graphics::Surface srcCopy = src;
-		srcCopy.format.aLoss = 8;
-
-		_screen->blitFrom(srcCopy);
-		break;
+	// Gather the regions to copy; a custom back buffer may be painted on
+	// by the plugins at any time, so it is always copied whole
+	Common::Array<Common::Rect> areas;
+	if (dirty_only && !_fullFrameDirty && virtualScreen == _origVirtualScreen.get()) {
+		for (const auto &rc : _dirtyRects)
+			areas.push_back(Common::Rect(rc.Left, rc.Top, rc.Right + 1, rc.Bottom + 1));
+	} else {
+		areas.push_back(Common::Rect(src.w, src.h));
 	}
+	_dirtyRects.clear();
+	_fullFrameDirty = false;
+
+	for (const auto &area : areas) {
+		switch (renderMode) {
+		case kRenderToABGR:
+			// ARGB to ABGR
+			copySurface(src, false, area);
+			break;
+
+		case kRenderToRGBA:
+			// ARGB to RGBA
+			copySurface(src, true, area);
+			break;
+
+		case kRenderOther: {
+			// Blit the surface to the temporary screen, ignoring the alphas.
+			// This takes care of converting to the screen format
+			Graphics::Surface srcCopy = src;
+			srcCopy.format.aLoss = 8;
+
+			_screen->blitFrom(srcCopy, area, Common::Point(area.left, area.top));
+			break;
+		}
 
-	case kRenderDirect:
-		// Blit the virtual surface directly to the screen
-		g_system->copyRectToScreen(src.getPixels(), src.pitch,
-			0, 0, src.w, src.h);
-		g_system->updateScreen();
-		return;
+		case kRenderDirect:
+			// Blit the virtual surface directly to the screen
+			g_system->copyRectToScreen(src.getBasePtr(area.left, area.top), src.pitch,
+				area.left, area.top, area.width(), area.height());
+			break;
 
-	default:
-		break;
+		default:
+			break;
+		}
 	}
 
-	if (_screen)
+	if (renderMode == kRenderDirect)
+		g_system->updateScreen();
+	else if (_screen)
 		_screen->update();
 }
 
@@ -489,7 +600,7 @@ void ScummVMRendererGraphicsDriver::Render(int /*xoff*/, int /*yoff*/, GlobalFli
 	}
 
 	RenderToBackBuffer();
-	Present();
+	BlitToScreen(true);
 }
 
 void ScummVMRendererGraphicsDriver::Render() {
@@ -500,6 +611,8 @@ void ScummVMRendererGraphicsDriver::Vsync() {
 }
 
 Bitmap *ScummVMRendererGraphicsDriver::GetMemoryBackBuffer() {
+	// The caller may paint anything on the returned bitmap
+	MarkFullFrameDirty();
 	return virtualScreen;
 }
 
@@ -510,6 +623,7 @@ void ScummVMRendererGraphicsDriver::SetMemoryBackBuffer(Bitmap *backBuffer) {
 		virtualScreen = _origVirtualScreen.get();
 	}
 	_stageVirtualScreen = virtualScreen;
+	MarkFullFrameDirty();
 
 	// Reset old virtual screen's subbitmaps
 	for (auto &batch : _spriteBatches) {
@@ -518,10 +632,18 @@ void ScummVMRendererGraphicsDriver::SetMemoryBackBuffer(Bitmap *backBuffer) {
 	}
 }
 
-Bitmap *ScummVMRendererGraphicsDriver::GetStageBackBuffer(bool /*mark_dirty*/) {
+Bitmap *ScummVMRendererGraphicsDriver::GetStageBackBuffer(bool mark_dirty) {
+	if (mark_dirty)
+		MarkFullFrameDirty();
 	return _stageVirtualScreen;
 }
 
+void ScummVMRendererGraphicsDriver::MarkStageDirtyRect(const Rect &rc) {
+	// Areas painted on a separate batch surface reach the screen with the batch
+	if (_stageVirtualScreen == virtualScreen)
+		MarkDirtyRect(rc);
+}
+
 bool ScummVMRendererGraphicsDriver::GetCopyOfScreenIntoBitmap(Bitmap *destination, bool at_native_res, GraphicResolution *want_fmt) {
 	(void)at_native_res; // software driver always renders at native resolution at the moment
 	// software filter is taught to copy to any size
@@ -94,6 +94,11 @@ public:
 	bool _opaque; // no mask color
 	bool _hasAlpha;
 	int _transparency;
+	// Changes each time the bitmap is (re)assigned by the driver, so that
+	// the renderer knows when to treat the sprite's area as dirty
+	uint32_t _version;
+	// Index of the last frame this bitmap was rendered on
+	uint32_t _drawnFrame;
 
 	ALSoftwareBitmap(Bitmap *bmp, bool opaque, bool hasAlpha) {
 		_bmp = bmp;
@@ -106,6 +111,8 @@ public:
 		_transparency = 0;
 		_opaque = opaque;
 		_hasAlpha = hasAlpha;
+		_version = 0;
+		_drawnFrame = 0;
 	}
 
 	int GetWidthToRender() {
@@ -149,6 +156,20 @@ private:
 
 
 typedef SpriteDrawListEntry<ALSoftwareBitmap> ALDrawListEntry;
+// Sprite state as it was last drawn, used to detect changed screen regions
+struct ALDrawnSprite {
+	const ALSoftwareBitmap *Ddb = nullptr;
+	uint32_t Version = 0;
+	int Transparency = 0;
+	// Sprite area on the virtual screen
+	Rect Area;
+
+	bool operator ==(const ALDrawnSprite &other) const {
+		return Ddb == other.Ddb && Version == other.Version &&
+			Transparency == other.Transparency && Area == other.Area;
+	}
+};
+
 // Software renderer's sprite batch
 struct ALSpriteBatch {
 	// List of sprites to render
@@ -159,6 +180,12 @@ struct ALSpriteBatch {
 	bool                         IsVirtualScreen;
 	// Tells whether the surface is treated as opaque or transparent
 	bool                         Opaque;
+	// Sprites and batch placement from the last time this batch was rendered
+	std::vector<ALDrawnSprite>   LastDrawn;
+	Rect                         LastViewport;
+	SpriteTransform              LastTransform;
+	Bitmap                      *LastSurface = nullptr;
+	bool                         HasLastDrawn = false;
 };
 typedef std::vector<ALSpriteBatch> ALSpriteBatches;
 
@@ -223,6 +250,7 @@ public:
 	Bitmap *GetMemoryBackBuffer() override;
 	void SetMemoryBackBuffer(Bitmap *backBuffer) override;
 	Bitmap *GetStageBackBuffer(bool mark_dirty) override;
+	void MarkStageDirtyRect(const Rect &rc) override;
 	bool GetStageMatrixes(RenderMatrixes &rm) override {
 		return false; /* not supported */
 	}
@@ -263,6 +291,15 @@ private:
 	int _tint_red, _tint_green, _tint_blue;
 
 	ALSpriteBatches _spriteBatches;
+	// Number of sprite batches rendered on the last frame
+	size_t _lastBatchCount = 0;
+	// Counters used to assign DDB versions and tell rendered frames apart
+	uint32_t _ddbVersion = 0;
+	uint32_t _frameIndex = 0;
+	// Virtual screen regions changed since the last presented frame;
+	// only these are copied to the screen, unless the full frame is dirty
+	std::vector<Rect> _dirtyRects;
+	bool _fullFrameDirty = true;
 
 	void InitSpriteBatch(size_t index, const SpriteBatchDesc &desc) override;
 	void ResetAllBatches() override;
@@ -274,14 +311,21 @@ private:
 	void ReleaseDisplayMode();
 	// Renders single sprite batch on the precreated surface
 	void RenderSpriteBatch(const ALSpriteBatch &batch, Shared::Bitmap *surface, int surf_offx, int surf_offy);
+	// Compares batch's sprites against the last rendered frame and marks changed regions as dirty
+	void UpdateBatchDirtyRegions(ALSpriteBatch &batch, const Rect &viewport, const SpriteTransform &transform);
+	// Marks the virtual screen region as needing to be copied to the screen
+	void MarkDirtyRect(const Rect &rc);
+	// Marks the whole virtual screen as needing to be copied to the screen
+	void MarkFullFrameDirty();
 
 	void highcolor_fade_in(Bitmap *vs, void(*draw_callback)(), int offx, int offy, int speed, int targetColourRed, int targetColourGreen, int targetColourBlue);
 	void highcolor_fade_out(Bitmap *vs, void(*draw_callback)(), int offx, int offy, int speed, int targetColourRed, int targetColourGreen, int targetColourBlue);
 	void __fade_from_range(PALETTE source, PALETTE dest, int speed, int from, int to);
 	void __fade_out_range(int speed, int from, int to, int targetColourRed, int targetColourGreen, int targetColourBlue);
-	// Copy raw screen bitmap pixels to the screen
-	void BlitToScreen();
-	void copySurface(const Graphics::Surface &src, bool mode);
+	// Copy raw screen bitmap pixels to the screen; if dirty_only is set,
+	// only the regions changed since the last presented frame are copied
+	void BlitToScreen(bool dirty_only = false);
+	void copySurface(const Graphics::Surface &src, bool mode, const Common::Rect &area);
 	// Render bitmap on screen
 	void Present() { BlitToScreen(); }
 };
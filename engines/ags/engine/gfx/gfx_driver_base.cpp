@@ -156,6 +156,10 @@ Bitmap *VideoMemoryGraphicsDriver::GetStageBackBuffer(bool mark_dirty) {
 	return _stageVirtualScreen.get();
 }
 
+void VideoMemoryGraphicsDriver::MarkStageDirtyRect(const Rect & /*rc*/) {
+	_stageScreenDirty = true;
+}
+
 bool VideoMemoryGraphicsDriver::GetStageMatrixes(RenderMatrixes &rm) {
 	rm = _stageMatrixes;
 	return true;
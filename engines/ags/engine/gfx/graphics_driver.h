@@ -191,6 +191,9 @@ public:
 	// Returns memory backbuffer for the current rendering stage (or base virtual screen if called outside of render pass).
 	// All renderers should support this.
 	virtual Shared::Bitmap *GetStageBackBuffer(bool mark_dirty) = 0;
+	// Tells renderer that the engine has painted over the given rect of the stage backbuffer
+	// (in screen coordinates), when it was requested without marking it dirty.
+	virtual void MarkStageDirtyRect(const Rect &rc) = 0;
 	// Retrieves 3 transform matrixes for the current rendering stage: world (model), view and projection.
 	// These matrixes will be filled in accordance to the renderer's compatible format;
 	// returns false if renderer does not use matrixes (not a 3D renderer).
@@ -223,6 +223,7 @@ ccInstance::ccInstance() {
 	numimports = 0;
 	resolved_imports = nullptr;
 	code_fixups         = nullptr;
+	code_ops            = nullptr;
 
 	memset(callStackLineNumber, 0, sizeof(callStackLineNumber));
 	memset(callStackAddr, 0, sizeof(callStackAddr));
@@ -433,37 +434,30 @@ int ccInstance::Run(int32_t curpc) {
 		*/
 		/* ReadOperation */
 		//=====================================================================
-		codeOp.Instruction.Code         = codeInst->code[pc];
-		codeOp.Instruction.InstanceId   = (codeOp.Instruction.Code >> INSTANCE_ID_SHIFT) & INSTANCE_ID_MASK;
-		codeOp.Instruction.Code        &= INSTANCE_ID_REMOVEMASK; // now this is pure instruction code
-
-		if (codeOp.Instruction.Code < 0 || codeOp.Instruction.Code >= CC_NUM_SCCMDS) {
-			cc_error("invalid instruction %d found in code stream", codeOp.Instruction.Code);
+		const ScriptCodeOp &op = codeInst->code_ops[pc];
+		if (op.Code < 0) {
+			int32_t instr = codeInst->code[pc] & INSTANCE_ID_REMOVEMASK;
+			if (op.Code == ScriptCodeOp::kInvalid)
+				cc_error("invalid instruction %d found in code stream", instr);
+			else
+				cc_error("unexpected end of code data (%d; %d)", pc + sccmd_info[instr].ArgCount, codeInst->codesize);
 			return -1;
 		}
 
-		codeOp.ArgCount = sccmd_info[codeOp.Instruction.Code].ArgCount;
-		if (pc + codeOp.ArgCount >= codeInst->codesize) {
-			cc_error("unexpected end of code data (%d; %d)", pc + codeOp.ArgCount, codeInst->codesize);
-			return -1;
-		}
+		codeOp.Instruction.Code         = op.Code;
+		codeOp.Instruction.InstanceId   = op.InstanceId;
+		codeOp.ArgCount                 = op.ArgCount;
 
-		int pc_at = pc + 1;
-		for (int i = 0; i < codeOp.ArgCount; ++i, ++pc_at) {
-			char fixup = codeInst->code_fixups[pc_at];
+		const intptr_t *arg_data = &codeInst->code[pc + 1];
+		for (int i = 0; i < codeOp.ArgCount; ++i) {
+			char fixup = op.ArgFixups[i];
 			if (fixup > 0) {
 				// could be relative pointer or import address
-				/*
-				if (!FixupArgument(code[pc], fixup, codeOp.Args[i]))
-				{
-				    return -1;
-				}
-				*/
 				/* FixupArgument */
 				//=====================================================================
 				switch (fixup) {
 				case FIXUP_GLOBALDATA: {
-					ScriptVariable *gl_var = (ScriptVariable *)codeInst->code[pc_at];
+					ScriptVariable *gl_var = (ScriptVariable *)arg_data[i];
 					codeOp.Args[i].SetGlobalVar(&gl_var->RValue);
 				}
 				break;
@@ -471,23 +465,23 @@ int ccInstance::Run(int32_t curpc) {
 					// originally commented -- CHECKME: could this be used in very old versions of AGS?
 					//      code[fixup] += (long)&code[0];
 					// This is a program counter value, presumably will be used as SCMD_CALL argument
-					codeOp.Args[i].SetInt32((int32_t)codeInst->code[pc_at]);
+					codeOp.Args[i].SetInt32((int32_t)arg_data[i]);
 					break;
 				case FIXUP_STRING:
-					codeOp.Args[i].SetStringLiteral(&codeInst->strings[0] + codeInst->code[pc_at]);
+					codeOp.Args[i].SetStringLiteral(&codeInst->strings[0] + arg_data[i]);
 					break;
 				case FIXUP_IMPORT: {
-					const ScriptImport *import = _GP(simp).getByIndex((int32_t)codeInst->code[pc_at]);
+					const ScriptImport *import = _GP(simp).getByIndex((int32_t)arg_data[i]);
 					if (import) {
 						codeOp.Args[i] = import->Value;
 					} else {
-						cc_error("cannot resolve import, key = %ld", codeInst->code[pc_at]);
+						cc_error("cannot resolve import, key = %ld", arg_data[i]);
 						return -1;
 					}
 				}
 				break;
 				case FIXUP_STACK:
-					codeOp.Args[i] = GetStackPtrOffsetFw((int32_t)codeInst->code[pc_at]);
+					codeOp.Args[i] = GetStackPtrOffsetFw((int32_t)arg_data[i]);
 					break;
 				default:
 					cc_error("internal fixup type error: %d", fixup);
@@ -497,7 +491,7 @@ int ccInstance::Run(int32_t curpc) {
 				//=====================================================================
 			} else {
 				// should be a numeric literal (int32 or float)
-				codeOp.Args[i].SetInt32((int32_t)codeInst->code[pc_at]);
+				codeOp.Args[i].SetInt32((int32_t)arg_data[i]);
 			}
 		}
 		/* End ReadOperation */
@@ -1391,6 +1385,7 @@ bool ccInstance::_Create(PScript scri, ccInstance *joined) {
 	if (joined) {
 		resolved_imports = joined->resolved_imports;
 		code_fixups = joined->code_fixups;
+		code_ops = joined->code_ops;
 	} else {
 		if (!ResolveScriptImports(scri)) {
 			return false;
@@ -1401,6 +1396,7 @@ bool ccInstance::_Create(PScript scri, ccInstance *joined) {
 		if (!CreateRuntimeCodeFixups(scri)) {
 			return false;
 		}
+		CreateRuntimeCodeOps();
 	}
 
 	exports = new RuntimeScriptValue[scri->numexports];
@@ -1476,9 +1472,11 @@ void ccInstance::Free() {
 	if ((flags & INSTF_SHAREDATA) == 0) {
 		delete[] resolved_imports;
 		delete[] code_fixups;
+		delete[] code_ops;
 	}
 	resolved_imports = nullptr;
 	code_fixups = nullptr;
+	code_ops = nullptr;
 }
 
 bool ccInstance::ResolveScriptImports(PScript scri) {
@@ -1656,6 +1654,33 @@ bool ccInstance::CreateRuntimeCodeFixups(PScript scri) {
 	return true;
 }
 
+void ccInstance::CreateRuntimeCodeOps() {
+	code_ops = new ScriptCodeOp[codesize];
+	for (int32_t at_pc = 0; at_pc < codesize; ++at_pc) {
+		ScriptCodeOp &op = code_ops[at_pc];
+		int32_t instr = (int32_t)code[at_pc];
+		op.InstanceId = (instr >> INSTANCE_ID_SHIFT) & INSTANCE_ID_MASK;
+		instr &= INSTANCE_ID_REMOVEMASK;
+		op.ArgCount = 0;
+		memset(op.ArgFixups, 0, sizeof(op.ArgFixups));
+
+		if (instr < 0 || instr >= CC_NUM_SCCMDS) {
+			op.Code = ScriptCodeOp::kInvalid;
+			continue;
+		}
+		int32_t want_args = sccmd_info[instr].ArgCount;
+		if (at_pc + want_args >= codesize) {
+			op.Code = ScriptCodeOp::kTruncated;
+			continue;
+		}
+
+		op.Code = instr;
+		op.ArgCount = want_args;
+		for (int i = 0; i < want_args; ++i)
+			op.ArgFixups[i] = code_fixups[at_pc + 1 + i];
+	}
+}
+
 /*
 bool ccInstance::ReadOperation(ScriptOperation &op, int32_t at_pc)
 {
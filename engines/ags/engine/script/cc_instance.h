@@ -71,6 +71,21 @@ struct ScriptOperation {
 	int                 ArgCount;
 };
 
+// Instruction decoded once when the script is loaded; there is one entry
+// for every position in the code array, so that Run() does not have to
+// validate the opcode and look up argument fixups on every step
+struct ScriptCodeOp {
+	enum {
+		kInvalid   = -1, // opcode is out of range
+		kTruncated = -2  // arguments run past the end of the code
+	};
+
+	int16_t Code;       // pure instruction code, or one of the error values
+	uint8_t InstanceId;
+	uint8_t ArgCount;
+	char    ArgFixups[MAX_SCMD_ARGS];
+};
+
 struct ScriptVariable {
 	ScriptVariable() {
 		ScAddress = -1; // address = 0 is valid one, -1 means undefined
@@ -142,6 +157,7 @@ public:
 	int  numimports;
 
 	char *code_fixups;
+	ScriptCodeOp *code_ops;
 
 	// returns the currently executing instance, or NULL if none
 	static ccInstance *GetCurrentInstance(void);
@@ -184,6 +200,7 @@ protected:
 	bool    AddGlobalVar(const ScriptVariable &glvar);
 	ScriptVariable *FindGlobalVar(int32_t var_addr);
 	bool    CreateRuntimeCodeFixups(PScript scri);
+	void    CreateRuntimeCodeOps();
 	//bool    ReadOperation(ScriptOperation &op, int32_t at_pc);
 
 	// Runtime fixups
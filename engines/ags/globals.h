@@ -1359,6 +1359,10 @@ public:
 
 	char *_walkBehindExists = nullptr;  // whether a WB area is in this column
 	int *_walkBehindStartY = nullptr, *_walkBehindEndY = nullptr;
+	// Runs of walk-behind pixels, stored column by column; runs of the
+	// column X are in range [_walkBehindColumnRuns[X], _walkBehindColumnRuns[X + 1])
+	std::vector<WalkBehindColumnRun> _walkBehindRuns;
+	std::vector<int> _walkBehindColumnRuns;
 	int8 _noWalkBehindsAtAll = 0;
 	int _walkBehindLeft[MAX_WALK_BEHINDS], _walkBehindTop[MAX_WALK_BEHINDS];
 	int _walkBehindRight[MAX_WALK_BEHINDS], _walkBehindBottom[MAX_WALK_BEHINDS];
@@ -107,6 +107,9 @@ void BITMAP::floodfill(int x, int y, int color) {
 const int SCALE_THRESHOLD = 0x100;
 #define VGA_COLOR_TRANS(x) ((x) * 255 / 63)
 
+// The 32-bit format used by AGS for all its high color bitmaps
+static const Graphics::PixelFormat ARGB8888(4, 8, 8, 8, 8, 16, 8, 0, 24);
+
 void BITMAP::draw(const BITMAP *srcBitmap, const Common::Rect &srcRect,
                   int dstX, int dstY, bool horizFlip, bool vertFlip,
                   bool skipTrans, int srcAlpha, int tintRed, int tintGreen,
@@ -133,114 +136,14 @@ void BITMAP::draw(const BITMAP *srcBitmap, const Common::Rect &srcRect,
 		// Area is entirely outside the clipping area, so nothing to draw
 		return;
 
-	// Get source and dest surface. Note that for the destination we create
-	// a temporary sub-surface based on the allowed clipping area
-	const Graphics::ManagedSurface &src = **srcBitmap;
-	Graphics::ManagedSurface &dest = *_owner;
-	Graphics::Surface destArea = dest.getSubArea(destRect);
-
-	// Define scaling and other stuff used by the drawing loops
-	const int xDir = horizFlip ? -1 : 1;
-	bool useTint = (tintRed >= 0 && tintGreen >= 0 && tintBlue >= 0);
-	bool sameFormat = (src.format == format);
-
-	byte rSrc, gSrc, bSrc, aSrc;
-	byte rDest = 0, gDest = 0, bDest = 0, aDest = 0;
-
-	PALETTE palette;
-	if (src.format.bytesPerPixel == 1 && format.bytesPerPixel != 1) {
-		for (int i = 0; i < PAL_SIZE; ++i) {
-			palette[i].r = VGA_COLOR_TRANS(_G(current_palette)[i].r);
-			palette[i].g = VGA_COLOR_TRANS(_G(current_palette)[i].g);
-			palette[i].b = VGA_COLOR_TRANS(_G(current_palette)[i].b);
-		}
-	}
-
-	uint32 transColor = 0, alphaMask = 0xff;
-	if (skipTrans && src.format.bytesPerPixel != 1) {
-		transColor = src.format.ARGBToColor(0, 255, 0, 255);
-		alphaMask = src.format.ARGBToColor(255, 0, 0, 0);
-		alphaMask = ~alphaMask;
-	}
-
-	int xStart = (dstRect.left < destRect.left) ? dstRect.left - destRect.left : 0;
-	int yStart = (dstRect.top < destRect.top) ? dstRect.top - destRect.top : 0;
-
-	for (int destY = yStart, yCtr = 0; yCtr < dstRect.height(); ++destY, ++yCtr) {
-		if (destY < 0 || destY >= destArea.h)
-			continue;
-		byte *destP = (byte *)destArea.getBasePtr(0, destY);
-		const byte *srcP = (const byte *)src.getBasePtr(
-		                       horizFlip ? srcArea.right - 1 : srcArea.left,
-		                       vertFlip ? srcArea.bottom - 1 - yCtr :
-		                       srcArea.top + yCtr);
-
-		// Loop through the pixels of the row
-		for (int destX = xStart, xCtr = 0, xCtrBpp = 0; xCtr < dstRect.width(); ++destX, ++xCtr, xCtrBpp += src.format.bytesPerPixel) {
-			if (destX < 0 || destX >= destArea.w)
-				continue;
-
-			const byte *srcVal = srcP + xDir * xCtrBpp;
-			uint32 srcCol = getColor(srcVal, src.format.bytesPerPixel);
-
-			// Check if this is a transparent color we should skip
-			if (skipTrans && ((srcCol & alphaMask) == transColor))
-				continue;
-
-			byte *destVal = (byte *)&destP[destX * format.bytesPerPixel];
-
-			// When blitting to the same format we can just copy the color
-			if (format.bytesPerPixel == 1) {
-				*destVal = srcCol;
-				continue;
-			} else if (sameFormat && srcAlpha == -1) {
-				if (format.bytesPerPixel == 4)
-					*(uint32 *)destVal = srcCol;
-				else
-					*(uint16 *)destVal = srcCol;
-				continue;
-			}
-
-			// We need the rgb values to do blending and/or convert between formats
-			if (src.format.bytesPerPixel == 1) {
-				const RGB &rgb = palette[srcCol];
-				aSrc = 0xff;
-				rSrc = rgb.r;
-				gSrc = rgb.g;
-				bSrc = rgb.b;
-			} else
-				src.format.colorToARGB(srcCol, aSrc, rSrc, gSrc, bSrc);
-
-			if (srcAlpha == -1) {
-				// This means we don't use blending.
-				aDest = aSrc;
-				rDest = rSrc;
-				gDest = gSrc;
-				bDest = bSrc;
-			} else {
-				if (useTint) {
-					rDest = rSrc;
-					gDest = gSrc;
-					bDest = bSrc;
-					aDest = aSrc;
-					rSrc = tintRed;
-					gSrc = tintGreen;
-					bSrc = tintBlue;
-					aSrc = srcAlpha;
-				} else {
-					// TODO: move this to blendPixel to only do it when needed?
-					format.colorToARGB(getColor(destVal, format.bytesPerPixel), aDest, rDest, gDest, bDest);
-				}
-				blendPixel(aSrc, rSrc, gSrc, bSrc, aDest, rDest, gDest, bDest, srcAlpha);
-			}
-
-			uint32 pixel = format.ARGBToColor(aDest, rDest, gDest, bDest);
-			if (format.bytesPerPixel == 4)
-				*(uint32 *)destVal = pixel;
-			else
-				*(uint16 *)destVal = pixel;
-		}
-	}
+	DrawInnerArgs args(**srcBitmap, srcArea, dstRect, destRect);
+	args.horizFlip = horizFlip;
+	args.vertFlip = vertFlip;
+	args.useTint = (tintRed >= 0 && tintGreen >= 0 && tintBlue >= 0);
+	args.tintRed = tintRed;
+	args.tintGreen = tintGreen;
+	args.tintBlue = tintBlue;
+	drawDispatch(args, skipTrans, srcAlpha, false);
 }
 
 void BITMAP::stretchDraw(const BITMAP *srcBitmap, const Common::Rect &srcRect,
@@ -260,77 +163,146 @@ void BITMAP::stretchDraw(const BITMAP *srcBitmap, const Common::Rect &srcRect,
 		// Area is entirely outside the clipping area, so nothing to draw
 		return;
 
-	// Get source and dest surface. Note that for the destination we create
-	// a temporary sub-surface based on the allowed clipping area
-	const Graphics::ManagedSurface &src = **srcBitmap;
-	Graphics::ManagedSurface &dest = *_owner;
-	Graphics::Surface destArea = dest.getSubArea(destRect);
+	DrawInnerArgs args(**srcBitmap, srcRect, dstRect, destRect);
+	args.scaleX = SCALE_THRESHOLD * srcRect.width() / dstRect.width();
+	args.scaleY = SCALE_THRESHOLD * srcRect.height() / dstRect.height();
+	drawDispatch(args, skipTrans, srcAlpha, true);
+}
 
-	// Define scaling and other stuff used by the drawing loops
-	const int scaleX = SCALE_THRESHOLD * srcRect.width() / dstRect.width();
-	const int scaleY = SCALE_THRESHOLD * srcRect.height() / dstRect.height();
-	bool sameFormat = (src.format == format);
+BITMAP::DrawInnerArgs::DrawInnerArgs(const Graphics::ManagedSurface &src_,
+		const Common::Rect &srcArea_, const Common::Rect &dstRect_, const Common::Rect &destRect_) :
+		src(src_), srcArea(srcArea_), dstRect(dstRect_), destRect(destRect_),
+		horizFlip(false), vertFlip(false), skipTrans(false), useTint(false), sameFormat(false),
+		packedArgb(false), srcAlpha(-1), tintRed(-1), tintGreen(-1), tintBlue(-1),
+		scaleX(SCALE_THRESHOLD), scaleY(SCALE_THRESHOLD), transColor(0), alphaMask(0xff),
+		blenderMode(kRgbToRgbBlender) {
+}
 
-	byte rSrc, gSrc, bSrc, aSrc;
-	byte rDest = 0, gDest = 0, bDest = 0, aDest = 0;
+void BITMAP::drawDispatch(DrawInnerArgs &args, bool skipTrans, int srcAlpha, bool scale) {
+	const Graphics::ManagedSurface &src = args.src;
+
+	args.skipTrans = skipTrans;
+	args.srcAlpha = srcAlpha;
+	args.sameFormat = (src.format == format);
+	args.blenderMode = _G(_blender_mode);
+	// Blenders working on the color channels only can operate on packed
+	// ARGB pixels directly, without unpacking them into components first
+	args.packedArgb = args.sameFormat && format == ARGB8888 && srcAlpha != -1 && !args.useTint &&
+		(args.blenderMode == kRgbToRgbBlender || args.blenderMode == kAlphaPreservedBlenderMode ||
+		 args.blenderMode == kSourceAlphaBlender || args.blenderMode == kArgbToRgbBlender);
 
-	PALETTE palette;
 	if (src.format.bytesPerPixel == 1 && format.bytesPerPixel != 1) {
 		for (int i = 0; i < PAL_SIZE; ++i) {
-			palette[i].r = VGA_COLOR_TRANS(_G(current_palette)[i].r);
-			palette[i].g = VGA_COLOR_TRANS(_G(current_palette)[i].g);
-			palette[i].b = VGA_COLOR_TRANS(_G(current_palette)[i].b);
+			args.palette[i].r = VGA_COLOR_TRANS(_G(current_palette)[i].r);
+			args.palette[i].g = VGA_COLOR_TRANS(_G(current_palette)[i].g);
+			args.palette[i].b = VGA_COLOR_TRANS(_G(current_palette)[i].b);
 		}
 	}
 
-	uint32 transColor = 0, alphaMask = 0xff;
 	if (skipTrans && src.format.bytesPerPixel != 1) {
-		transColor = src.format.ARGBToColor(0, 255, 0, 255);
-		alphaMask = src.format.ARGBToColor(255, 0, 0, 0);
-		alphaMask = ~alphaMask;
+		args.transColor = src.format.ARGBToColor(0, 255, 0, 255);
+		args.alphaMask = src.format.ARGBToColor(255, 0, 0, 0);
+		args.alphaMask = ~args.alphaMask;
+	}
+
+#define DRAW_INNER(DEST_BPP, SRC_BPP) \
+	if (scale) \
+		drawInner<DEST_BPP, SRC_BPP, true>(args); \
+	else \
+		drawInner<DEST_BPP, SRC_BPP, false>(args)
+
+	switch (format.bytesPerPixel * 8 + src.format.bytesPerPixel) {
+	case 1 * 8 + 1:
+		DRAW_INNER(1, 1);
+		break;
+	case 2 * 8 + 1:
+		DRAW_INNER(2, 1);
+		break;
+	case 2 * 8 + 2:
+		DRAW_INNER(2, 2);
+		break;
+	case 2 * 8 + 4:
+		DRAW_INNER(2, 4);
+		break;
+	case 4 * 8 + 1:
+		DRAW_INNER(4, 1);
+		break;
+	case 4 * 8 + 2:
+		DRAW_INNER(4, 2);
+		break;
+	case 4 * 8 + 4:
+		DRAW_INNER(4, 4);
+		break;
+	default:
+		error("Unsupported format in BITMAP::draw");
 	}
 
-	int xStart = (dstRect.left < destRect.left) ? dstRect.left - destRect.left : 0;
-	int yStart = (dstRect.top < destRect.top) ? dstRect.top - destRect.top : 0;
+#undef DRAW_INNER
+}
+
+template<int DestBytesPerPixel, int SrcBytesPerPixel, bool Scale>
+void BITMAP::drawInner(const DrawInnerArgs &args) {
+	const Graphics::ManagedSurface &src = args.src;
+	const Common::Rect &srcArea = args.srcArea;
+	const Common::Rect &dstRect = args.dstRect;
+	// For the destination we create a temporary sub-surface based on
+	// the allowed clipping area
+	Graphics::Surface destArea = _owner->getSubArea(args.destRect);
 
-	for (int destY = yStart, yCtr = 0, scaleYCtr = 0; yCtr < dstRect.height();
-	        ++destY, ++yCtr, scaleYCtr += scaleY) {
-		if (destY < 0 || destY >= destArea.h)
-			continue;
-		byte *destP = (byte *)destArea.getBasePtr(0, destY);
-		const byte *srcP = (const byte *)src.getBasePtr(
-		                       srcRect.left, srcRect.top + scaleYCtr / SCALE_THRESHOLD);
+	const int xDir = args.horizFlip ? -1 : 1;
+	const bool skipTrans = args.skipTrans;
+	const int srcAlpha = args.srcAlpha;
+	const uint32 transColor = args.transColor, alphaMask = args.alphaMask;
 
-		// Loop through the pixels of the row
-		for (int destX = xStart, xCtr = 0, scaleXCtr = 0; xCtr < dstRect.width();
-		        ++destX, ++xCtr, scaleXCtr += scaleX) {
-			if (destX < 0 || destX >= destArea.w)
-				continue;
+	byte rSrc, gSrc, bSrc, aSrc;
+	byte rDest = 0, gDest = 0, bDest = 0, aDest = 0;
 
-			const byte *srcVal = srcP + scaleXCtr / SCALE_THRESHOLD * src.format.bytesPerPixel;
-			uint32 srcCol = getColor(srcVal, src.format.bytesPerPixel);
+	// Clip the rows and columns to the dest area up front
+	const int xStart = (dstRect.left < args.destRect.left) ? dstRect.left - args.destRect.left : 0;
+	const int yStart = (dstRect.top < args.destRect.top) ? dstRect.top - args.destRect.top : 0;
+	const int xCtrStart = MAX(0, -xStart), xCtrEnd = MIN<int>(dstRect.width(), destArea.w - xStart);
+	const int yCtrStart = MAX(0, -yStart), yCtrEnd = MIN<int>(dstRect.height(), destArea.h - yStart);
+
+	for (int yCtr = yCtrStart; yCtr < yCtrEnd; ++yCtr) {
+		byte *destP = (byte *)destArea.getBasePtr(0, yStart + yCtr);
+		const byte *srcP;
+		if (Scale)
+			srcP = (const byte *)src.getBasePtr(srcArea.left, srcArea.top + yCtr * args.scaleY / SCALE_THRESHOLD);
+		else
+			srcP = (const byte *)src.getBasePtr(
+			           args.horizFlip ? srcArea.right - 1 : srcArea.left,
+			           args.vertFlip ? srcArea.bottom - 1 - yCtr : srcArea.top + yCtr);
+
+		// Loop through the pixels of the row
+		for (int xCtr = xCtrStart; xCtr < xCtrEnd; ++xCtr) {
+			const byte *srcVal;
+			if (Scale)
+				srcVal = srcP + xCtr * args.scaleX / SCALE_THRESHOLD * SrcBytesPerPixel;
+			else
+				srcVal = srcP + xDir * xCtr * SrcBytesPerPixel;
+			uint32 srcCol = getColor<SrcBytesPerPixel>(srcVal);
 
 			// Check if this is a transparent color we should skip
 			if (skipTrans && ((srcCol & alphaMask) == transColor))
 				continue;
 
-			byte *destVal = (byte *)&destP[destX * format.bytesPerPixel];
+			byte *destVal = &destP[(xStart + xCtr) * DestBytesPerPixel];
 
 			// When blitting to the same format we can just copy the color
-			if (format.bytesPerPixel == 1) {
+			if (DestBytesPerPixel == 1) {
 				*destVal = srcCol;
 				continue;
-			} else if (sameFormat && srcAlpha == -1) {
-				if (format.bytesPerPixel == 4)
-					*(uint32 *)destVal = srcCol;
-				else
-					*(uint16 *)destVal = srcCol;
+			} else if (args.sameFormat && srcAlpha == -1) {
+				setColor<DestBytesPerPixel>(destVal, srcCol);
+				continue;
+			} else if (DestBytesPerPixel == 4 && args.packedArgb) {
+				*(uint32 *)destVal = blendPackedArgb(srcCol, *(const uint32 *)destVal, srcAlpha, args.blenderMode);
 				continue;
 			}
 
 			// We need the rgb values to do blending and/or convert between formats
-			if (src.format.bytesPerPixel == 1) {
-				const RGB &rgb = palette[srcCol];
+			if (SrcBytesPerPixel == 1) {
+				const RGB &rgb = args.palette[srcCol];
 				aSrc = 0xff;
 				rSrc = rgb.r;
 				gSrc = rgb.g;
@@ -345,22 +317,28 @@ void BITMAP::stretchDraw(const BITMAP *srcBitmap, const Common::Rect &srcRect,
 				gDest = gSrc;
 				bDest = bSrc;
 			} else {
-				// TODO: move this to blendPixel to only do it when needed?
-				format.colorToARGB(getColor(destVal, format.bytesPerPixel), aDest, rDest, gDest, bDest);
-				blendPixel(aSrc, rSrc, gSrc, bSrc, aDest, rDest, gDest, bDest, srcAlpha);
+				if (args.useTint) {
+					rDest = rSrc;
+					gDest = gSrc;
+					bDest = bSrc;
+					aDest = aSrc;
+					rSrc = args.tintRed;
+					gSrc = args.tintGreen;
+					bSrc = args.tintBlue;
+					aSrc = srcAlpha;
+				} else {
+					format.colorToARGB(getColor<DestBytesPerPixel>(destVal), aDest, rDest, gDest, bDest);
+				}
+				blendPixel(aSrc, rSrc, gSrc, bSrc, aDest, rDest, gDest, bDest, srcAlpha, args.blenderMode);
 			}
 
-			uint32 pixel = format.ARGBToColor(aDest, rDest, gDest, bDest);
-			if (format.bytesPerPixel == 4)
-				*(uint32 *)destVal = pixel;
-			else
-				*(uint16 *)destVal = pixel;
+			setColor<DestBytesPerPixel>(destVal, format.ARGBToColor(aDest, rDest, gDest, bDest));
 		}
 	}
 }
 
-void BITMAP::blendPixel(uint8 aSrc, uint8 rSrc, uint8 gSrc, uint8 bSrc, uint8 &aDest, uint8 &rDest, uint8 &gDest, uint8 &bDest, uint32 alpha) const {
-	switch (_G(_blender_mode)) {
+void BITMAP::blendPixel(uint8 aSrc, uint8 rSrc, uint8 gSrc, uint8 bSrc, uint8 &aDest, uint8 &rDest, uint8 &gDest, uint8 &bDest, uint32 alpha, BlenderMode mode) const {
+	switch (mode) {
 	case kSourceAlphaBlender:
 		blendSourceAlpha(aSrc, rSrc, gSrc, bSrc, aDest, rDest, gDest, bDest, alpha);
 		break;
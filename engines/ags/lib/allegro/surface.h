@@ -24,6 +24,7 @@
 
 #include "graphics/managed_surface.h"
 #include "ags/lib/allegro/base.h"
+#include "ags/lib/allegro/color.h"
 #include "common/array.h"
 
 namespace AGS3 {
@@ -124,12 +125,66 @@ public:
 	}
 
 	private:
+	// Parameters of a draw or stretchDraw call, shared with the drawing loops
+	struct DrawInnerArgs {
+		const Graphics::ManagedSurface &src;
+		Common::Rect srcArea, dstRect, destRect;
+		bool horizFlip, vertFlip, skipTrans, useTint, sameFormat, packedArgb;
+		int srcAlpha, tintRed, tintGreen, tintBlue;
+		int scaleX, scaleY;
+		uint32 transColor, alphaMask;
+		BlenderMode blenderMode;
+		PALETTE palette;
+
+		DrawInnerArgs(const Graphics::ManagedSurface &src_, const Common::Rect &srcArea_,
+			const Common::Rect &dstRect_, const Common::Rect &destRect_);
+	};
+
+	// Sets up the common drawing parameters, and runs the drawing loop
+	// specialized for the source and destination formats
+	void drawDispatch(DrawInnerArgs &args, bool skipTrans, int srcAlpha, bool scale);
+
+	template<int DestBytesPerPixel, int SrcBytesPerPixel, bool Scale>
+	void drawInner(const DrawInnerArgs &args);
+
 	// True color blender functions
 	// In Allegro all the blender functions are of the form
 	// unsigned int blender_func(unsigned long x, unsigned long y, unsigned long n)
 	// when x is the sprite color, y the destination color, and n an alpha value
 
-	void blendPixel(uint8 aSrc, uint8 rSrc, uint8 gSrc, uint8 bSrc, uint8 &aDest, uint8 &rDest, uint8 &gDest, uint8 &bDest, uint32 alpha) const;
+	void blendPixel(uint8 aSrc, uint8 rSrc, uint8 gSrc, uint8 bSrc, uint8 &aDest, uint8 &rDest, uint8 &gDest, uint8 &bDest, uint32 alpha, BlenderMode mode) const;
+
+	// Same as blendPixel for the blenders based on rgbBlend, but working
+	// on ARGB8888 pixels without splitting them into components
+	static inline uint32 blendPackedArgb(uint32 srcCol, uint32 destCol, uint32 alpha, BlenderMode mode) {
+		uint32 aDest = 0;
+		switch (mode) {
+		case kSourceAlphaBlender:
+			alpha = srcCol >> 24;
+			break;
+		case kArgbToRgbBlender:
+			if (alpha == 0)
+				alpha = srcCol >> 24;
+			else
+				alpha = (srcCol >> 24) * ((alpha & 0xff) + 1) / 256;
+			break;
+		case kAlphaPreservedBlenderMode:
+			aDest = destCol & 0xff000000;
+			break;
+		default:
+			break;
+		}
+		if (alpha)
+			alpha++;
+
+		uint32 x = srcCol & 0xffffff;
+		uint32 y = destCol & 0xffffff;
+		uint32 res = ((x & 0xFF00FF) - (y & 0xFF00FF)) * alpha / 256 + y;
+		y &= 0xFF00;
+		x &= 0xFF00;
+		uint32 g = (x - y) * alpha / 256 + y;
+		return aDest | (res & 0xFF00FF) | (g & 0xFF00);
+	}
 
 
 	inline void rgbBlend(uint8 rSrc, uint8 gSrc, uint8 bSrc, uint8 &rDest, uint8 &gDest, uint8 &bDest, uint32 alpha) const {
@@ -265,16 +320,30 @@ public:
 	void blendTintSprite(uint8 aSrc, uint8 rSrc, uint8 gSrc, uint8 bSrc, uint8 &aDest, uint8 &rDest, uint8 &gDest, uint8 &bDest, uint32 alpha, bool light) const;
 
 
-	inline uint32 getColor(const byte *data, byte bpp) const {
-		switch (bpp) {
+	template<int BytesPerPixel>
+	static inline uint32 getColor(const byte *data) {
+		switch (BytesPerPixel) {
 		case 1:
 			return *data;
 		case 2:
 			return *(const uint16 *)data;
-		case 4:
+		default:
 			return *(const uint32 *)data;
+		}
+	}
+
+	template<int BytesPerPixel>
+	static inline void setColor(byte *data, uint32 color) {
+		switch (BytesPerPixel) {
+		case 1:
+			*data = color;
+			break;
+		case 2:
+			*(uint16 *)data = color;
+			break;
 		default:
-			error("Unsupported format in BITMAP::getColor");
+			*(uint32 *)data = color;
+			break;
 		}
 	}
 };
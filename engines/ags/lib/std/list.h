@@ -62,6 +62,21 @@ public:
 		return pos;
 	}
 
+	// Moves the element at it from other to before pos, without reallocating it
+	void splice(typename Common::List<T>::iterator pos, list &other,
+			typename Common::List<T>::iterator it) {
+		typename Common::List<T>::NodeBase *node = it._node;
+		typename Common::List<T>::NodeBase *next = pos._node;
+		if (node == next || node->_next == next)
+			return;
+		node->_prev->_next = node->_next;
+		node->_next->_prev = node->_prev;
+		node->_prev = next->_prev;
+		node->_next = next;
+		next->_prev->_next = node;
+		next->_prev = node;
+	}
+
 	reverse_iterator rbegin() {
 		return reverse_iterator(Common::List<T>::reverse_begin());
 	}
@@ -41,6 +41,7 @@
 #include "ags/shared/gfx/bitmap.h"
 #include "ags/shared/util/compress.h"
 #include "ags/shared/util/file.h"
+#include "ags/shared/util/memory_stream.h"
 #include "ags/shared/util/stream.h"
 #include "ags/globals.h"
 
@@ -110,6 +111,18 @@ size_t SpriteCache::GetSpriteSlotCount() const {
 	return _spriteData.size();
 }
 
+size_t SpriteCache::GetCompressedCacheSize() const {
+	return _compressedSize;
+}
+
+const SpriteCacheStats &SpriteCache::GetStats() const {
+	return _stats;
+}
+
+void SpriteCache::ResetStats() {
+	_stats = SpriteCacheStats();
+}
+
 sprkey_t SpriteFile::FindTopmostSprite(const std::vector<Bitmap *> &sprites) {
 	sprkey_t topmost = -1;
 	for (sprkey_t i = 0; i < static_cast<sprkey_t>(sprites.size()); ++i)
@@ -128,10 +141,12 @@ void SpriteCache::Init() {
 	_maxCacheSize = (size_t)DEFAULTCACHESIZE_KB * 1024;
 	_liststart = -1;
 	_listend = -1;
+	_compressedSize = 0;
 }
 
 void SpriteCache::Reset() {
 	_file.Reset();
+	ClearCompressedCache();
 	// TODO: find out if it's safe to simply always delete _spriteData.Image with array element
 	for (size_t i = 0; i < _spriteData.size(); ++i) {
 		if (_spriteData[i].Image) {
@@ -256,6 +271,8 @@ Bitmap *SpriteCache::operator [] (sprkey_t index) {
 	// Sprite exists in file but is not in mem, load it
 	if ((_spriteData[index].Image == nullptr) && _spriteData[index].IsAssetSprite())
 		LoadSprite(index);
+	else
+		_stats.Hits++;
 
 	// Locked sprite that shouldn't be put into MRU list
 	if (_spriteData[index].IsLocked())
@@ -305,6 +322,7 @@ void SpriteCache::DisposeOldest() {
 
 		delete _spriteData[sprnum].Image;
 		_spriteData[sprnum].Image = nullptr;
+		_stats.Disposed++;
 	}
 
 	if (_liststart == _listend) {
@@ -351,6 +369,7 @@ void SpriteCache::DisposeAll() {
 		_mrubacklink[i] = 0;
 	}
 	_cacheSize = _lockedSize;
+	ClearCompressedCache();
 }
 
 void SpriteCache::Precache(sprkey_t index) {
@@ -375,6 +394,21 @@ void SpriteCache::Precache(sprkey_t index) {
 #endif
 }
 
+void SpriteCache::PrefetchSprite(sprkey_t index) {
+	if (index < 0 || (size_t)index >= _spriteData.size())
+		return;
+	if ((_spriteData[index].Image != nullptr) || !_spriteData[index].IsAssetSprite())
+		return;
+	// Only use free space, prefetching should not push out sprites in use.
+	// The bitmap is assumed to be 32-bit, as the engine may convert it on load.
+	const size_t est_size = (size_t)_sprInfos[index].Width * _sprInfos[index].Height * 4;
+	if (_cacheSize >= _maxCacheSize || est_size > _maxCacheSize - _cacheSize)
+		return;
+
+	_stats.Prefetched++;
+	(*this)[index];
+}
+
 sprkey_t SpriteCache::GetDataIndex(sprkey_t index) {
 	return (_spriteData[index].Flags & SPRCACHEFLAG_REMAPPED) == 0 ? index : 0;
 }
@@ -402,9 +436,10 @@ size_t SpriteCache::LoadSprite(sprkey_t index) {
 	if (index < 0 || (size_t)index >= _spriteData.size())
 		quit("sprite cache array index out of bounds");
 
+	_stats.Misses++;
 	sprkey_t load_index = GetDataIndex(index);
 	Bitmap *image;
-	HError err = _file.LoadSprite(load_index, image);
+	HError err = LoadSpriteBitmap(load_index, image);
 	if (!image) {
 		Debug::Printf(kDbgGroup_SprCache, kDbgMsg_Warn,
 			"LoadSprite: failed to load sprite %d:\n%s\n - remapping to sprite 0.", index,
@@ -445,6 +480,51 @@ size_t SpriteCache::LoadSprite(sprkey_t index) {
 	return size;
 }
 
+HError SpriteCache::LoadSpriteBitmap(sprkey_t load_index, Bitmap *&image) {
+	// Uncompressed sprites would take as much memory as their bitmaps
+	if (!_file.IsFileCompressed())
+		return _file.LoadSprite(load_index, image);
+
+	image = nullptr;
+	auto it = _compressedSprites.find(load_index);
+	if (it != _compressedSprites.end()) {
+		_stats.CompressedHits++;
+		CompressedSprite &spr = it->_value;
+		_compressedOrder.splice(_compressedOrder.end(), _compressedOrder, spr.OrderIt);
+		return _file.DecodeSpriteData(load_index, spr.Metric, spr.BPP, spr.Data, image);
+	}
+
+	CompressedSprite &spr = _compressedSprites[load_index];
+	HError err = _file.LoadSpriteData(load_index, spr.Metric, spr.BPP, spr.Data);
+	if (err)
+		err = _file.DecodeSpriteData(load_index, spr.Metric, spr.BPP, spr.Data, image);
+
+	// The compressed data gets a quarter of the bitmap cache limit
+	const size_t max_size = _maxCacheSize / 4;
+	const size_t data_size = spr.Data.size();
+	if (!image || data_size > max_size) {
+		_compressedSprites.erase(load_index);
+		return err;
+	}
+
+	_compressedSize += data_size;
+	_compressedOrder.push_back(load_index);
+	spr.OrderIt = --_compressedOrder.end();
+	while (_compressedSize > max_size) {
+		sprkey_t oldest = _compressedOrder.front();
+		_compressedOrder.pop_front();
+		_compressedSize -= _compressedSprites[oldest].Data.size();
+		_compressedSprites.erase(oldest);
+	}
+	return err;
+}
+
+void SpriteCache::ClearCompressedCache() {
+	_compressedSprites.clear();
+	_compressedOrder.clear();
+	_compressedSize = 0;
+}
+
 void SpriteCache::RemapSpriteToSprite0(sprkey_t index) {
 	_sprInfos[index].Flags = _sprInfos[0].Flags;
 	_sprInfos[index].Width = _sprInfos[0].Width;
@@ -608,6 +688,7 @@ int SpriteFile::SaveSpriteIndex(const String &filename, const SpriteFileIndex &i
 }
 
 HError SpriteCache::InitFile(const String &filename, const String &sprindex_filename) {
+	ClearCompressedCache();
 	std::vector<Size> metrics;
 	HError err = _file.OpenFile(filename, sprindex_filename, metrics);
 	if (!err)
@@ -756,51 +837,12 @@ void SpriteFile::Reset() {
 
 HAGSError SpriteFile::LoadSprite(sprkey_t index, Shared::Bitmap *&sprite) {
 	sprite = nullptr;
-	if (index < 0 || (size_t)index >= _spriteData.size())
-		new Error(String::FromFormat("LoadSprite: slot index %d out of bounds (%d - %d).",
-			index, 0, _spriteData.size() - 1));
-
-	if (_spriteData[index].Offset == 0)
-		return HError::None(); // sprite is not in file
-
-	SeekToSprite(index);
-	_curPos = -2; // mark undefined pos
-
-	int coldep = _stream->ReadInt16();
-	if (coldep == 0) { // empty slot, this is normal
-		return HError::None();
-	}
-
-	int wdd = _stream->ReadInt16();
-	int htt = _stream->ReadInt16();
-	Bitmap *image = BitmapHelper::CreateBitmap(wdd, htt, coldep * 8);
-	if (image == nullptr) {
-		return new Error(String::FromFormat("LoadSprite: failed to allocate bitmap %d (%dx%d%d).",
-			index, wdd, htt, coldep * 8));
-	}
-
-	if (_compressed) {
-		size_t data_size = _stream->ReadInt32();
-		if (data_size == 0) {
-			delete image;
-			return new Error(String::FromFormat("LoadSprite: bad compressed data for sprite %d.", index));
-		}
-		rle_decompress(image, _stream.get());
-	} else {
-		if (coldep == 1) {
-			for (int h = 0; h < htt; ++h)
-				_stream->ReadArray(&image->GetScanLineForWriting(h)[0], coldep, wdd);
-		} else if (coldep == 2) {
-			for (int h = 0; h < htt; ++h)
-				_stream->ReadArrayOfInt16((int16_t *)&image->GetScanLineForWriting(h)[0], wdd);
-		} else {
-			for (int h = 0; h < htt; ++h)
-				_stream->ReadArrayOfInt32((int32_t *)&image->GetScanLineForWriting(h)[0], wdd);
-		}
-	}
-	sprite = image;
-	_curPos = index + 1; // mark correct pos
-	return HError::None();
+	Size metric;
+	int bpp;
+	HError err = LoadSpriteData(index, metric, bpp, _loadBuffer);
+	if (!err)
+		return err;
+	return DecodeSpriteData(index, metric, bpp, _loadBuffer, sprite);
 }
 
 HError SpriteFile::LoadSpriteData(sprkey_t index, Size &metric, int &bpp,
@@ -809,7 +851,7 @@ HError SpriteFile::LoadSpriteData(sprkey_t index, Size &metric, int &bpp,
 	bpp = 0;
 
 	if (index < 0 || (size_t)index >= _spriteData.size())
-		new Error(String::FromFormat("LoadSprite: slot index %d out of bounds (%d - %d).",
+		return new Error(String::FromFormat("LoadSprite: slot index %d out of bounds (%d - %d).",
 			index, 0, _spriteData.size() - 1));
 
 	if (_spriteData[index].Offset == 0)
@@ -835,13 +877,48 @@ HError SpriteFile::LoadSpriteData(sprkey_t index, Size &metric, int &bpp,
 	else
 		data_size = width * height * coldep;
 	data.resize(data_size);
-	_stream->Read(&data[0], data_size);
+	if (data_size > 0)
+		_stream->Read(&data[0], data_size);
 	metric = Size(width, height);
 	bpp = coldep;
 	_curPos = index + 1; // mark correct pos
 	return HError::None();
 }
 
+HError SpriteFile::DecodeSpriteData(sprkey_t index, const Size &metric, int bpp,
+		const std::vector<char> &data, Bitmap *&sprite) const {
+	sprite = nullptr;
+	if (bpp == 0) // empty slot, this is normal
+		return HError::None();
+
+	Bitmap *image = BitmapHelper::CreateBitmap(metric.Width, metric.Height, bpp * 8);
+	if (image == nullptr) {
+		return new Error(String::FromFormat("LoadSprite: failed to allocate bitmap %d (%dx%d%d).",
+			index, metric.Width, metric.Height, bpp * 8));
+	}
+
+	if (_compressed) {
+		if (data.size() == 0) {
+			delete image;
+			return new Error(String::FromFormat("LoadSprite: bad compressed data for sprite %d.", index));
+		}
+		MemoryStream in(data);
+		rle_decompress(image, &in);
+	} else {
+		MemoryStream in(data);
+		for (int h = 0; h < metric.Height; ++h) {
+			if (bpp == 1)
+				in.ReadArray(&image->GetScanLineForWriting(h)[0], bpp, metric.Width);
+			else if (bpp == 2)
+				in.ReadArrayOfInt16((int16_t *)&image->GetScanLineForWriting(h)[0], metric.Width);
+			else
+				in.ReadArrayOfInt32((int32_t *)&image->GetScanLineForWriting(h)[0], metric.Width);
+		}
+	}
+	sprite = image;
+	return HError::None();
+}
+
 HAGSError SpriteFile::OpenFile(const String &filename, const String &sprindex_filename,
 	std::vector<Size> &metrics) {
 	SpriteFileVersion vers;
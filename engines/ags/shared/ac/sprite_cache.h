@@ -41,6 +41,8 @@
 #ifndef AGS_SHARED_AC_SPRITE_CACHE_H
 #define AGS_SHARED_AC_SPRITE_CACHE_H
 
+#include "ags/lib/std/list.h"
+#include "ags/lib/std/map.h"
 #include "ags/lib/std/memory.h"
 #include "ags/lib/std/vector.h"
 #include "ags/shared/core/platform.h"
@@ -133,6 +135,9 @@ public:
 
 	HAGSError LoadSprite(sprkey_t index, Shared::Bitmap *&sprite);
 	HAGSError LoadSpriteData(sprkey_t index, Size &metric, int &bpp, std::vector<char> &data);
+	// Creates a bitmap from the data previously read by LoadSpriteData
+	HAGSError DecodeSpriteData(sprkey_t index, const Size &metric, int bpp,
+		const std::vector<char> &data, Shared::Bitmap *&sprite) const;
 
 	// Saves all sprites to file; fills in index data for external use
 	// TODO: refactor to be able to save main file and index file separately (separate function for gather data?)
@@ -160,6 +165,16 @@ private:
 	std::unique_ptr<Shared::Stream> _stream; // the sprite stream
 	bool _compressed; // are sprites compressed
 	sprkey_t _curPos; // current stream position (sprite slot)
+	std::vector<char> _loadBuffer; // raw sprite data read by LoadSprite
+};
+
+// Counters describing how well the sprite cache performs
+struct SpriteCacheStats {
+	uint32_t Hits = 0;           // requested sprite was already loaded
+	uint32_t Misses = 0;         // sprite had to be loaded
+	uint32_t CompressedHits = 0; // ...of those, decoded from the compressed data kept in memory
+	uint32_t Prefetched = 0;     // loaded ahead of use when entering a room
+	uint32_t Disposed = 0;       // bitmaps freed to keep the cache under its limit
 };
 
 class SpriteCache {
@@ -218,6 +233,14 @@ public:
 	void        SubstituteBitmap(sprkey_t index, Shared::Bitmap *);
 	// Sets max cache size in bytes
 	void        SetMaxCacheSize(size_t size);
+	// Returns the size of the compressed sprite data kept in memory, in bytes
+	size_t      GetCompressedCacheSize() const;
+	// Loads the sprite if it is not in memory yet and there is room for it in
+	// the cache; unlike Precache the sprite may be disposed normally later
+	void        PrefetchSprite(sprkey_t index);
+	// Returns the cache usage counters
+	const SpriteCacheStats &GetStats() const;
+	void        ResetStats();
 
 	// Loads (if it's not in cache yet) and returns bitmap by the sprite index
 	Shared::Bitmap *operator[] (sprkey_t index);
@@ -231,6 +254,10 @@ private:
 	sprkey_t    GetDataIndex(sprkey_t index);
 	// Delete the oldest image in cache
 	void        DisposeOldest();
+	// Load sprite bitmap, using and filling the compressed sprite cache
+	HAGSError   LoadSpriteBitmap(sprkey_t load_index, Shared::Bitmap *&image);
+	// Deletes all compressed sprite data
+	void        ClearCompressedCache();
 
 	// Information required for the sprite streaming
 	// TODO: split into sprite cache and sprite stream data
@@ -273,6 +300,22 @@ private:
 	int _liststart;
 	int _listend;
 
+	// Raw data of sprites read from a compressed sprite file. This is a
+	// second cache level: compressed sprites take a fraction of the memory
+	// of their bitmaps, so more of them can be kept, and a sprite that was
+	// disposed may be restored without reading the file again.
+	struct CompressedSprite {
+		Size Metric;
+		int BPP = 0;
+		std::vector<char> Data;
+		std::list<sprkey_t>::iterator OrderIt; // position in _compressedOrder
+	};
+	std::unordered_map<sprkey_t, CompressedSprite> _compressedSprites;
+	std::list<sprkey_t> _compressedOrder; // least recently used first
+	size_t _compressedSize;
+
+	SpriteCacheStats _stats;
+
 	// Initialize the empty sprite slot
 	void        InitNullSpriteParams(sprkey_t index);
 };
@@ -370,6 +370,17 @@ static void setupLookupTable(int t[256], int inc) {
 	}
 }
 
+template <typename T>
+static void drawSliceSpan(void *line, uint16 *zbufferLine, int x, int xEnd, uint16 z, uint32 color) {
+	T *dst = (T *)line;
+	for (; x != xEnd; ++x) {
+		if (z < zbufferLine[x]) {
+			zbufferLine[x] = z;
+			dst[x] = (T)color;
+		}
+	}
+}
+
 void SliceRenderer::drawInWorld(int animationId, int animationFrame, Vector3 position, float facing, float scale, Graphics::Surface &surface, uint16 *zbuffer) {
 	assert(_lights);
 	assert(_setEffects);
@@ -544,6 +555,11 @@ void SliceRenderer::drawSlice(int slice, bool advanced, int y, Graphics::Surface
 
 	SliceAnimations::Palette &palette = _vm->_sliceAnimations->getPalette(_framePaletteIndex);
 
+	// Spans are never wider than 640 pixels, so on a full size surface
+	// the whole line can be written without clipping each pixel
+	void *line = surface.getBasePtr(0, CLIP(y, 0, surface.h - 1));
+	bool clipX = surface.w < 640;
+
 	byte *p = (byte *)_sliceFramePtr + 0x20 + 4 * slice;
 
 	uint32 polyOffset = READ_LE_UINT32(p);
@@ -571,7 +587,14 @@ void SliceRenderer::drawSlice(int slice, bool advanced, int y, Graphics::Surface
 			if (vertexX > previousVertexX) {
 				int vertexZ = (_m21lookup[p[0]] + _m22lookup[p[1]] + _m23) / 64;
 
-				if (vertexZ >= 0 && vertexZ < 65536) {
+				// Skip the hidden part of the span, actors are often
+				// mostly behind each other or the set
+				int x = previousVertexX;
+				while (x != vertexX && vertexZ >= zbufferLine[x]) {
+					++x;
+				}
+
+				if (x != vertexX && vertexZ >= 0) {
 					uint32 outColor = palette.value[p[2]];
 					if (advanced) {
 						Color256 aescColor = { 0, 0, 0 };
@@ -585,12 +608,18 @@ void SliceRenderer::drawSlice(int slice, bool advanced, int y, Graphics::Surface
 						outColor = _pixelFormat.RGBToColor(Color::get8BitColorFrom5Bit(color.r), Color::get8BitColorFrom5Bit(color.g), Color::get8BitColorFrom5Bit(color.b));
 					}
 
-					for (int x = previousVertexX; x != vertexX; ++x) {
-						if (vertexZ < zbufferLine[x]) {
-							zbufferLine[x] = (uint16)vertexZ;
-
-							void *dstPtr = surface.getBasePtr(CLIP(x, 0, surface.w - 1), CLIP(y, 0, surface.h - 1));
-							drawPixel(surface, dstPtr, outColor);
+					if (!clipX && surface.format.bytesPerPixel == 2) {
+						drawSliceSpan<uint16>(line, zbufferLine, x, vertexX, vertexZ, outColor);
+					} else if (!clipX && surface.format.bytesPerPixel == 4) {
+						drawSliceSpan<uint32>(line, zbufferLine, x, vertexX, vertexZ, outColor);
+					} else {
+						for (; x != vertexX; ++x) {
+							if (vertexZ < zbufferLine[x]) {
+								zbufferLine[x] = (uint16)vertexZ;
+
+								void *dstPtr = surface.getBasePtr(CLIP(x, 0, surface.w - 1), CLIP(y, 0, surface.h - 1));
+								drawPixel(surface, dstPtr, outColor);
+							}
 						}
 					}
 				}
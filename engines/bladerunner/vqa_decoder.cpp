@@ -269,6 +269,20 @@ void VQADecoder::readFrame(int frame, uint readFlags) {
 	readPacket(readFlags);
 }
 
+void VQADecoder::prefetchCodebooks(int begin, int end) {
+	uint count = _codebooks.size();
+	for (uint i = 0; i != count; ++i) {
+		// A codebook is used from its frame until the frame of the next one
+		int first = _codebooks[i].frame;
+		int last = (i + 1 != count) ? _codebooks[i + 1].frame - 1 : numFrames() - 1;
+
+		if (_codebooks[i].data || first > end || last < begin) {
+			continue;
+		}
+		readFrame(first, kVQAReadCodebook);
+	}
+}
+
 bool VQADecoder::readVQHD(Common::SeekableReadStream *s, uint32 size) {
 	if (size != 42)
 		return false;
@@ -625,6 +639,8 @@ VQADecoder::VQAVideoTrack::VQAVideoTrack(VQADecoder *vqaDecoder) {
 
 	_lightsDataSize = 0;
 	_lightsData     = nullptr;
+
+	_colorLookup = nullptr;
 }
 
 VQADecoder::VQAVideoTrack::~VQAVideoTrack() {
@@ -635,6 +651,7 @@ VQADecoder::VQAVideoTrack::~VQAVideoTrack() {
 	delete[] _viewData;
 	delete[] _screenEffectsData;
 	delete[] _lightsData;
+	delete[] _colorLookup;
 }
 
 uint16 VQADecoder::VQAVideoTrack::getWidth() const {
@@ -828,43 +845,70 @@ bool VQADecoder::VQAVideoTrack::readVPTR(Common::SeekableReadStream *s, uint32 s
 	return true;
 }
 
-void VQADecoder::VQAVideoTrack::VPTRWriteBlock(Graphics::Surface *surface, unsigned int dstBlock, unsigned int srcBlock, int count, bool alpha) {
-	const uint8 *const block_src = &_codebook[2 * srcBlock * _blockW * _blockH];
+void VQADecoder::VQAVideoTrack::updateColorLookup(const Graphics::PixelFormat &format) {
+	if (_colorLookup && _colorLookupFormat == format) {
+		return;
+	}
 
-	uint16 blocks_per_line = _width / _blockW;
+	if (!_colorLookup) {
+		_colorLookup = new uint32[0x8000];
+	}
+	_colorLookupFormat = format;
 
-	uint32 intermDiv = 0;
-	uint32 dst_x = 0;
-	uint32 dst_y = 0;
-	uint16 vqaColor = 0;
 	uint8 a, r, g, b;
+	for (uint16 vqaColor = 0; vqaColor != 0x8000; ++vqaColor) {
+		getGameDataColor(vqaColor, a, r, g, b);
+		// Ignore the alpha in the output as it is inversed in the input
+		_colorLookup[vqaColor] = format.RGBToColor(r, g, b);
+	}
+}
+
+template <typename T>
+void VQADecoder::VQAVideoTrack::VPTRWriteBlock(Graphics::Surface *surface, unsigned int dstBlock, const uint8 *blockSrc, int count, bool alpha) {
+	uint16 blocks_per_line = _width / _blockW;
 
 	for (uint i = count; i != 0; --i) {
-		intermDiv = (dstBlock + count - i) / blocks_per_line;
-		dst_x = ((dstBlock + count - i) - intermDiv * blocks_per_line) * _blockW + _offsetX;
-		dst_y = intermDiv * _blockH + _offsetY;
+		uint32 intermDiv = (dstBlock + count - i) / blocks_per_line;
+		uint32 dst_x = ((dstBlock + count - i) - intermDiv * blocks_per_line) * _blockW + _offsetX;
+		uint32 dst_y = intermDiv * _blockH + _offsetY;
 
-		const uint8 *src_p = block_src;
+		const uint8 *src_p = blockSrc;
+
+		for (uint y = 0; y != _blockH; ++y) {
+			// clip is too slow and it is not needed
+			T *dst_p = (T *)surface->getBasePtr(dst_x, dst_y + y);
 
-		for (uint y = _blockH; y != 0; --y) {
 			for (uint x = _blockW; x != 0; --x) {
-				vqaColor = READ_LE_UINT16(src_p);
+				uint16 vqaColor = READ_LE_UINT16(src_p);
 				src_p += 2;
 
-				getGameDataColor(vqaColor, a, r, g, b);
-
-				if (!(alpha && a)) {
-					// clip is too slow and it is not needed
-					// void* dstPtr = surface->getBasePtr(CLIP(dst_x + x, (uint32)0, (uint32)(surface->w - 1)), CLIP(dst_y + y, (uint32)0, (uint32)(surface->h - 1)));
-					void* dstPtr = surface->getBasePtr(dst_x + _blockW - x, dst_y + _blockH - y);
-					// Ignore the alpha in the output as it is inversed in the input
-					drawPixel(*surface, dstPtr, surface->format.RGBToColor(r, g, b));
+				if (!(alpha && (vqaColor & 0x8000))) {
+					*dst_p = (T)_colorLookup[vqaColor & 0x7FFF];
 				}
+				++dst_p;
 			}
 		}
 	}
 }
 
+void VQADecoder::VQAVideoTrack::VPTRWriteBlock(Graphics::Surface *surface, unsigned int dstBlock, unsigned int srcBlock, int count, bool alpha) {
+	const uint8 *const block_src = &_codebook[2 * srcBlock * _blockW * _blockH];
+
+	switch (surface->format.bytesPerPixel) {
+	case 1:
+		VPTRWriteBlock<uint8>(surface, dstBlock, block_src, count, alpha);
+		break;
+	case 2:
+		VPTRWriteBlock<uint16>(surface, dstBlock, block_src, count, alpha);
+		break;
+	case 4:
+		VPTRWriteBlock<uint32>(surface, dstBlock, block_src, count, alpha);
+		break;
+	default:
+		break;
+	}
+}
+
 bool VQADecoder::VQAVideoTrack::decodeFrame(Graphics::Surface *surface) {
 	CodebookInfo &codebookInfo = _vqaDecoder->codebookInfoForFrame(_vqaDecoder->_decodingFrame);
 
@@ -876,6 +920,8 @@ bool VQADecoder::VQAVideoTrack::decodeFrame(Graphics::Surface *surface) {
 	if (!_codebook || !_vpointer)
 		return false;
 
+	updateColorLookup(surface->format);
+
 	uint8 *src = _vpointer;
 	uint8 *end = _vpointer + _vpointerSize;
 
@@ -63,6 +63,10 @@ public:
 
 	void readFrame(int frame, uint readFlags = kVQAReadAll);
 
+	// Decompresses the codebooks used by frames begin to end, so a loop
+	// does not stall the first time it reaches a new codebook
+	void prefetchCodebooks(int begin, int end);
+
 	void                        decodeVideoFrame(Graphics::Surface *surface, int frame, bool forceDraw = false);
 	void                        decodeZBuffer(ZBuffer *zbuffer);
 	Audio::SeekableAudioStream *decodeAudioFrame();
@@ -232,6 +236,14 @@ public:
 		uint8   *_screenEffectsData;
 		uint32   _screenEffectsDataSize;
 
+		// Codebook color to surface color, for all 15-bit colors
+		uint32                *_colorLookup;
+		Graphics::PixelFormat  _colorLookupFormat;
+
+		void updateColorLookup(const Graphics::PixelFormat &format);
+
+		template <typename T>
+		void VPTRWriteBlock(Graphics::Surface *surface, unsigned int dstBlock, const uint8 *blockSrc, int count, bool alpha);
 		void VPTRWriteBlock(Graphics::Surface *surface, unsigned int dstBlock, unsigned int srcBlock, int count, bool alpha = false);
 		bool decodeFrame(Graphics::Surface *surface);
 	};
@@ -284,6 +284,8 @@ bool VQAPlayer::setBeginAndEndFrame(int begin, int end, int repeatsCount, int lo
 
 	_frameBeginNext = begin;
 
+	_decoder.prefetchCodebooks(begin, end);
+
 	if (loopSetMode == kLoopSetModeJustStart) {
 		_repeatsCount = repeatsCount;
 		_frameEnd = end;
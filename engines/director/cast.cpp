@@ -84,9 +84,17 @@ Cast::Cast(Movie *movie, uint16 castLibID, bool isShared) {
 	_loadedCast = nullptr;
 
 	_defaultPalette = -1;
+
+	_loadTime = 0;
+	_bitmapBytes = 0;
+	_bitmapPeakBytes = 0;
+	_bitmapLoads = 0;
 }
 
 Cast::~Cast() {
+	debugC(1, kDebugLoading, "Cast::~Cast(): %s: loaded in %d ms, %d bitmap decodes, %d bytes resident, %d bytes peak",
+		_macName.c_str(), _loadTime, _bitmapLoads, _bitmapBytes, _bitmapPeakBytes);
+
 	if (_loadedStxts)
 		for (Common::HashMap<int, const Stxt *>::iterator it = _loadedStxts->begin(); it != _loadedStxts->end(); ++it)
 			delete it->_value;
@@ -305,6 +313,8 @@ bool Cast::loadConfig() {
 }
 
 void Cast::loadCast() {
+	uint32 startTime = g_system->getMillis();
+
 	// Palette Information
 	Common::Array<uint16> clutList = _castArchive->getResourceIDList(MKTAG('C', 'L', 'U', 'T'));
 	if (clutList.size() == 0) {
@@ -463,6 +473,10 @@ void Cast::loadCast() {
 
 	loadCastChildren();
 	loadSoundCasts();
+
+	_loadTime = g_system->getMillis() - startTime;
+	debugC(1, kDebugLoading, "Cast::loadCast(): %s: %d members in %d ms, %d bytes of bitmaps resident",
+		_macName.c_str(), _loadedCast->size(), _loadTime, _bitmapBytes);
 }
 
 void Cast::copyCastStxts() {
@@ -487,9 +501,8 @@ void Cast::copyCastStxts() {
 }
 
 void Cast::loadCastChildren() {
-	debugC(1, kDebugLoading, "****** Preloading sprite palettes and images");
+	debugC(1, kDebugLoading, "****** Preloading sprite palettes and film loops");
 
-	Cast *sharedCast = _movie ? _movie->getSharedCast() : nullptr;
 	Common::HashMap<int, PaletteV4>::iterator p = _vm->getLoadedPalettes().find(0);
 
 	for (Common::HashMap<int, CastMember *>::iterator c = _loadedCast->begin(); c != _loadedCast->end(); ++c) {
@@ -542,84 +555,146 @@ void Cast::loadCastChildren() {
 		if (c->_value->_type != kCastBitmap)
 			continue;
 
-		// Then handle bitmaps
+		// Bitmaps are decoded on first use, see BitmapCastMember::getImage().
+		// Those whose pixels depend on the palette active while decoding
+		// are decoded upfront instead, and kept.
 		BitmapCastMember *bitmapCast = (BitmapCastMember *)c->_value;
-		uint32 tag = bitmapCast->_tag;
-		uint16 imgId = c->_key;
-		uint16 realId = 0;
-
-		Image::ImageDecoder *img = nullptr;
-		Common::SeekableReadStream *pic = nullptr;
-
-		if (_version >= kFileVer400) {
-			if (bitmapCast->_children.size() > 0) {
-				imgId = bitmapCast->_children[0].index;
-				tag = bitmapCast->_children[0].tag;
-
-				if (_castArchive->hasResource(tag, imgId))
-					pic = _castArchive->getResource(tag, imgId);
-				else if (sharedCast && sharedCast->getArchive()->hasResource(tag, imgId))
-					pic = sharedCast->getArchive()->getResource(tag, imgId);
-			}
-		} else {
-			if (_loadedCast->contains(imgId)) {
-				bitmapCast->_tag = tag = ((BitmapCastMember *)_loadedCast->getVal(imgId))->_tag;
-				realId = imgId + _castIDoffset;
-				pic = _castArchive->getResource(tag, realId);
-			} else if (sharedCast && sharedCast->_loadedCast && sharedCast->_loadedCast->contains(imgId)) {
-				bitmapCast->_tag = tag = ((BitmapCastMember *)sharedCast->_loadedCast->getVal(imgId))->_tag;
-				realId = imgId + sharedCast->_castIDoffset;
-				pic = sharedCast->getArchive()->getResource(tag, realId);
-			}
-		}
+		if (!canUnloadBitmap(bitmapCast))
+			bitmapCast->getImage();
+	}
+}
 
-		if (pic == nullptr) {
-			warning("Cast::loadCastChildren(): Bitmap image %d not found", imgId);
-			continue;
+bool Cast::canUnloadBitmap(const BitmapCastMember *bitmapCast) const {
+	// The decoder maps pixels through the current palette when converting
+	// between colour depths: palette indices for true colour output, and
+	// 16/32-bit bitmaps to the closest palette entries for 8-bit output.
+	// Only 8-bit output of bitmaps up to 8 bits keeps the raw indices.
+	return _vm->_pixelformat.bytesPerPixel == 1 && bitmapCast->_bitsPerPixel <= 8;
+}
+
+Image::ImageDecoder *Cast::loadBitmapImage(BitmapCastMember *bitmapCast) {
+	Cast *sharedCast = _movie ? _movie->getSharedCast() : nullptr;
+	uint32 tag = bitmapCast->_tag;
+	uint16 imgId = bitmapCast->getID();
+	uint16 realId = 0;
+
+	Image::ImageDecoder *img = nullptr;
+	Common::SeekableReadStream *pic = nullptr;
+
+	if (_version >= kFileVer400) {
+		if (bitmapCast->_children.size() > 0) {
+			imgId = bitmapCast->_children[0].index;
+			tag = bitmapCast->_children[0].tag;
+
+			if (_castArchive->hasResource(tag, imgId))
+				pic = _castArchive->getResource(tag, imgId);
+			else if (sharedCast && sharedCast->getArchive()->hasResource(tag, imgId))
+				pic = sharedCast->getArchive()->getResource(tag, imgId);
 		}
+	} else {
+		if (_loadedCast->contains(imgId)) {
+			bitmapCast->_tag = tag = ((BitmapCastMember *)_loadedCast->getVal(imgId))->_tag;
+			realId = imgId + _castIDoffset;
+			pic = _castArchive->getResource(tag, realId);
+		} else if (sharedCast && sharedCast->_loadedCast && sharedCast->_loadedCast->contains(imgId)) {
+			bitmapCast->_tag = tag = ((BitmapCastMember *)sharedCast->_loadedCast->getVal(imgId))->_tag;
+			realId = imgId + sharedCast->_castIDoffset;
+			pic = sharedCast->getArchive()->getResource(tag, realId);
+		}
+	}
 
-		int w = bitmapCast->_initialRect.width();
-		int h = bitmapCast->_initialRect.height();
+	if (pic == nullptr) {
+		warning("Cast::loadBitmapImage(): Bitmap image %d not found", imgId);
+		return nullptr;
+	}
 
-		switch (tag) {
-		case MKTAG('D', 'I', 'B', ' '):
-			debugC(2, kDebugLoading, "****** Loading 'DIB ' id: %d (%d), %d bytes", imgId, realId, (int)pic->size());
-			img = new DIBDecoder();
-			break;
+	int w = bitmapCast->_initialRect.width();
+	int h = bitmapCast->_initialRect.height();
 
-		case MKTAG('B', 'I', 'T', 'D'):
-			debugC(2, kDebugLoading, "****** Loading 'BITD' id: %d (%d), %d bytes", imgId, realId, (int)pic->size());
+	switch (tag) {
+	case MKTAG('D', 'I', 'B', ' '):
+		debugC(2, kDebugLoading, "****** Loading 'DIB ' id: %d (%d), %d bytes", imgId, realId, (int)pic->size());
+		img = new DIBDecoder();
+		break;
 
-			if (w > 0 && h > 0) {
-				if (_version < kFileVer600) {
-					img = new BITDDecoder(w, h, bitmapCast->_bitsPerPixel, bitmapCast->_pitch, _vm->getPalette(), _version);
-				} else {
-					img = new Image::BitmapDecoder();
-				}
+	case MKTAG('B', 'I', 'T', 'D'):
+		debugC(2, kDebugLoading, "****** Loading 'BITD' id: %d (%d), %d bytes", imgId, realId, (int)pic->size());
+
+		if (w > 0 && h > 0) {
+			if (_version < kFileVer600) {
+				img = new BITDDecoder(w, h, bitmapCast->_bitsPerPixel, bitmapCast->_pitch, _vm->getPalette(), _version);
 			} else {
-				warning("Cast::loadCastChildren(): Bitmap image %d not found", imgId);
+				img = new Image::BitmapDecoder();
 			}
+		} else {
+			warning("Cast::loadBitmapImage(): Bitmap image %d not found", imgId);
+		}
 
-			break;
+		break;
 
-		default:
-			warning("Cast::loadCastChildren(): Unknown Bitmap CastMember Tag: [%d] %s", tag, tag2str(tag));
-			break;
-		}
+	default:
+		warning("Cast::loadBitmapImage(): Unknown Bitmap CastMember Tag: [%d] %s", tag, tag2str(tag));
+		break;
+	}
 
-		if (!img)
-			continue;
+	if (!img) {
+		delete pic;
+		return nullptr;
+	}
 
-		img->loadStream(*pic);
+	img->loadStream(*pic);
 
-		bitmapCast->_img = img;
-		const Graphics::Surface *surf = img->getSurface();
-		bitmapCast->_size = surf->pitch * surf->h + img->getPaletteColorCount() * 3;
+	const Graphics::Surface *surf = img->getSurface();
+	bitmapCast->_size = surf->pitch * surf->h + img->getPaletteColorCount() * 3;
 
-		delete pic;
+	delete pic;
 
-		debugC(4, kDebugImages, "Cast::loadCastChildren(): Bitmap: id: %d, w: %d, h: %d, flags1: %x, flags2: %x bytes: %x, bpp: %d clut: %x", imgId, w, h, bitmapCast->_flags1, bitmapCast->_flags2, bitmapCast->_bytes, bitmapCast->_bitsPerPixel, bitmapCast->_clut);
+	debugC(4, kDebugImages, "Cast::loadBitmapImage(): Bitmap: id: %d, w: %d, h: %d, flags1: %x, flags2: %x bytes: %x, bpp: %d clut: %x", imgId, w, h, bitmapCast->_flags1, bitmapCast->_flags2, bitmapCast->_bytes, bitmapCast->_bitsPerPixel, bitmapCast->_clut);
+
+	_bitmapLoads++;
+	return img;
+}
+
+// Decoded bitmaps beyond this are dropped, least recently used first,
+// and decoded again from the archive when needed
+#define BITMAP_CACHE_BUDGET (32 * 1024 * 1024)
+
+void Cast::touchBitmap(BitmapCastMember *bitmapCast) {
+	if (!bitmapCast->_imgCounted) {
+		bitmapCast->_imgCounted = true;
+		_bitmapBytes += bitmapCast->_size;
+		_bitmapPeakBytes = MAX(_bitmapPeakBytes, _bitmapBytes);
 	}
+
+	if (!canUnloadBitmap(bitmapCast))
+		return;
+
+	if (bitmapCast->_imgInLRU) {
+		if (bitmapCast->_lruNode == _bitmapLRU.begin())
+			return;
+		_bitmapLRU.erase(bitmapCast->_lruNode);
+	}
+	_bitmapLRU.push_front(bitmapCast);
+	bitmapCast->_lruNode = _bitmapLRU.begin();
+	bitmapCast->_imgInLRU = true;
+
+	while (_bitmapBytes > BITMAP_CACHE_BUDGET && _bitmapLRU.back() != bitmapCast) {
+		BitmapCastMember *victim = _bitmapLRU.back();
+		_bitmapLRU.pop_back();
+		_bitmapBytes -= victim->_size;
+		victim->_imgCounted = false;
+		victim->_imgInLRU = false;
+		victim->unloadImage();
+	}
+}
+
+void Cast::forgetBitmap(BitmapCastMember *bitmapCast) {
+	if (bitmapCast->_imgInLRU)
+		_bitmapLRU.erase(bitmapCast->_lruNode);
+	if (bitmapCast->_imgCounted)
+		_bitmapBytes -= bitmapCast->_size;
+	bitmapCast->_imgCounted = false;
+	bitmapCast->_imgInLRU = false;
 }
 
 void Cast::loadSoundCasts() {
@@ -23,6 +23,7 @@
 #define DIRECTOR_CAST_H
 
 #include "common/hash-str.h"
+#include "common/list.h"
 
 namespace Common {
 	class ReadStreamEndian;
@@ -30,6 +31,10 @@ namespace Common {
 	class SeekableReadStreamEndian;
 }
 
+namespace Image {
+	class ImageDecoder;
+}
+
 namespace Director {
 
 class Archive;
@@ -87,6 +92,11 @@ public:
 	void loadCastChildren();
 	void loadSoundCasts();
 
+	Image::ImageDecoder *loadBitmapImage(BitmapCastMember *bitmapCast);
+	void touchBitmap(BitmapCastMember *bitmapCast);
+	void forgetBitmap(BitmapCastMember *bitmapCast);
+	bool canUnloadBitmap(const BitmapCastMember *bitmapCast) const;
+
 	void copyCastStxts();
 	Common::Rect getCastMemberInitialRect(int castId);
 	void setCastMemberModified(int castId);
@@ -149,6 +159,13 @@ private:
 	Common::HashMap<uint16, CastMemberInfo *> _castsInfo;
 	Common::HashMap<Common::String, int, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> _castsNames;
 	Common::HashMap<uint16, int> _castsScriptIds;
+
+	// Decoded bitmaps that may be dropped, most recently used first
+	Common::List<BitmapCastMember *> _bitmapLRU;
+	uint32 _bitmapBytes;
+	uint32 _bitmapPeakBytes;
+	uint32 _bitmapLoads;
+	uint32 _loadTime;
 };
 
 } // End of namespace Director
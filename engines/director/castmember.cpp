@@ -66,6 +66,9 @@ BitmapCastMember::BitmapCastMember(Cast *cast, uint16 castId, Common::SeekableRe
 		: CastMember(cast, castId, stream) {
 	_type = kCastBitmap;
 	_img = nullptr;
+	_imgMissing = false;
+	_imgCounted = false;
+	_imgInLRU = false;
 	_matte = nullptr;
 	_noMatte = false;
 	_bytes = 0;
@@ -169,15 +172,34 @@ BitmapCastMember::BitmapCastMember(Cast *cast, uint16 castId, Common::SeekableRe
 }
 
 BitmapCastMember::~BitmapCastMember() {
-	if (_img)
+	if (_img) {
+		_cast->forgetBitmap(this);
 		delete _img;
+	}
 
 	if (_matte)
 		delete _matte;
 }
 
+Image::ImageDecoder *BitmapCastMember::getImage() {
+	if (!_img && !_imgMissing) {
+		_img = _cast->loadBitmapImage(this);
+		_imgMissing = !_img;
+	}
+
+	if (_img)
+		_cast->touchBitmap(this);
+
+	return _img;
+}
+
+void BitmapCastMember::unloadImage() {
+	delete _img;
+	_img = nullptr;
+}
+
 Graphics::MacWidget *BitmapCastMember::createWidget(Common::Rect &bbox, Channel *channel, SpriteType spriteType) {
-	if (!_img) {
+	if (!getImage()) {
 		warning("BitmapCastMember::createWidget: No image decoder");
 		return nullptr;
 	}
@@ -195,6 +217,10 @@ Graphics::MacWidget *BitmapCastMember::createWidget(Common::Rect &bbox, Channel
 }
 
 void BitmapCastMember::copyStretchImg(Graphics::Surface *surface, const Common::Rect &bbox) {
+	Image::ImageDecoder *img = getImage();
+	if (!img)
+		return;
+
 	if (bbox.width() != _initialRect.width() || bbox.height() != _initialRect.height()) {
 
 		int scaleX = SCALE_THRESHOLD * _initialRect.width() / bbox.width();
@@ -203,18 +229,18 @@ void BitmapCastMember::copyStretchImg(Graphics::Surface *surface, const Common::
 		for (int y = 0, scaleYCtr = 0; y < bbox.height(); y++, scaleYCtr += scaleY) {
 			if (g_director->_wm->_pixelformat.bytesPerPixel == 1) {
 				for (int x = 0, scaleXCtr = 0; x < bbox.width(); x++, scaleXCtr += scaleX) {
-					const byte *src = (const byte *)_img->getSurface()->getBasePtr(scaleXCtr / SCALE_THRESHOLD, scaleYCtr / SCALE_THRESHOLD);
+					const byte *src = (const byte *)img->getSurface()->getBasePtr(scaleXCtr / SCALE_THRESHOLD, scaleYCtr / SCALE_THRESHOLD);
 					*(byte *)surface->getBasePtr(x, y) = *src;
 				}
 			} else {
 				for (int x = 0, scaleXCtr = 0; x < bbox.width(); x++, scaleXCtr += scaleX) {
-					const int *src = (const int *)_img->getSurface()->getBasePtr(scaleXCtr / SCALE_THRESHOLD, scaleYCtr / SCALE_THRESHOLD);
+					const int *src = (const int *)img->getSurface()->getBasePtr(scaleXCtr / SCALE_THRESHOLD, scaleYCtr / SCALE_THRESHOLD);
 					*(int *)surface->getBasePtr(x, y) = *src;
 				}
 			}
 		}
 	} else {
-		surface->copyFrom(*_img->getSurface());
+		surface->copyFrom(*img->getSurface());
 	}
 }
 
@@ -121,11 +121,20 @@ public:
 	Graphics::Surface *getMatte(Common::Rect &bbox);
 	void copyStretchImg(Graphics::Surface *surface, const Common::Rect &bbox);
 
+	// Decodes the bitmap on first use. The cast may drop it again when
+	// over its memory budget, so don't hold on to the result.
+	Image::ImageDecoder *getImage();
+	void unloadImage();
+
 	bool hasField(int field) override;
 	Datum getField(int field) override;
 	bool setField(int field, const Datum &value) override;
 
 	Image::ImageDecoder *_img;
+	bool _imgMissing;
+	bool _imgCounted; // _img is counted in the cast's bitmap memory
+	bool _imgInLRU;   // _img may be dropped, see _lruNode
+	Common::List<BitmapCastMember *>::iterator _lruNode;
 	Graphics::FloodFill *_matte;
 
 	uint16 _pitch;
@@ -219,6 +219,22 @@ bool Channel::isStretched() {
 		(_sprite->_width != _width || _sprite->_height != _height);
 }
 
+// Whether drawing the channel overwrites every pixel of its bbox
+bool Channel::isOpaque() {
+	if (!_visible || !_widget || hasSubChannels() || isStretched() || isActiveVideo())
+		return false;
+
+	if (_sprite->_spriteType != kBitmapSprite || !_sprite->_cast || _sprite->_cast->_type != kCastBitmap)
+		return false;
+
+	// Copy is the only ink which neither masks nor blends
+	if (_sprite->_ink != kInkTypeCopy || _sprite->_blend > 0)
+		return false;
+
+	Common::Rect bbox = getBbox();
+	return _widget->getSurface()->w >= bbox.width() && _widget->getSurface()->h >= bbox.height();
+}
+
 bool Channel::isEmpty() {
 	return (_sprite->_spriteType == kInactiveSprite);
 }
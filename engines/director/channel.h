@@ -55,6 +55,7 @@ public:
 	bool isMatteWithin(Channel *channel);
 	bool isActiveVideo();
 	bool isVideoDirectToStage();
+	bool isOpaque();
 
 	void setWidth(int w);
 	void setHeight(int h);
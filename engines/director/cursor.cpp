@@ -84,6 +84,8 @@ void Cursor::readFromCast(Datum cursorCasts) {
 
 	BitmapCastMember *cursorBitmap = (BitmapCastMember *)cursorCast;
 	BitmapCastMember *maskBitmap = (BitmapCastMember *)maskCast;
+	Image::ImageDecoder *cursorImg = cursorBitmap->getImage();
+	Image::ImageDecoder *maskImg = maskBitmap->getImage();
 
 	_surface = new byte[getWidth() * getHeight()];
 	byte *dst = _surface;
@@ -91,15 +93,15 @@ void Cursor::readFromCast(Datum cursorCasts) {
 	for (int y = 0; y < 16; y++) {
 		const byte *cursor = nullptr, *mask = nullptr;
 
-		if (y < cursorBitmap->_img->getSurface()->h &&
-				y < maskBitmap->_img->getSurface()->h) {
-			cursor = (const byte *)cursorBitmap->_img->getSurface()->getBasePtr(0, y);
-			mask = (const byte *)maskBitmap->_img->getSurface()->getBasePtr(0, y);
+		if (y < cursorImg->getSurface()->h &&
+				y < maskImg->getSurface()->h) {
+			cursor = (const byte *)cursorImg->getSurface()->getBasePtr(0, y);
+			mask = (const byte *)maskImg->getSurface()->getBasePtr(0, y);
 		}
 
 		for (int x = 0; x < 16; x++) {
-			if (x >= cursorBitmap->_img->getSurface()->w ||
-					x >= maskBitmap->_img->getSurface()->w) {
+			if (x >= cursorImg->getSurface()->w ||
+					x >= maskImg->getSurface()->w) {
 				cursor = mask = nullptr;
 			}
 
@@ -152,6 +152,7 @@ struct DirectorPlotData {
 	// graphics.cpp
 	void setApplyColor();
 	uint32 preprocessColor(uint32 src);
+	bool canInkBlitSpans();
 	void inkBlitShape(Common::Rect &srcRect);
 	void inkBlitSurface(Common::Rect &srcRect, const Graphics::Surface *mask);
 	void inkBlitStretchSurface(Common::Rect &srcRect, const Graphics::Surface *mask);
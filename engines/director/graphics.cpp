@@ -408,6 +408,129 @@ void DirectorPlotData::inkBlitShape(Common::Rect &srcRect) {
 	}
 }
 
+// Row kernels for the inks which don't need colour lookups. Each one
+// gets a whole span of unmasked pixels at a time.
+struct InkCopyOp {
+	template <typename T>
+	static void span(T *dst, const T *src, int len) { memcpy(dst, src, len * sizeof(T)); }
+};
+
+struct InkBackgndTransOp {
+	uint32 backColor;
+	template <typename T>
+	void span(T *dst, const T *src, int len) const {
+		for (int i = 0; i < len; i++)
+			if ((uint32)src[i] != backColor)
+				dst[i] = src[i];
+	}
+};
+
+#define INK_BITWISE_OP(name, expr) \
+	struct name { \
+		template <typename T> \
+		static void span(T *dst, const T *src, int len) { \
+			for (int i = 0; i < len; i++) \
+				dst[i] = (T)(expr); \
+		} \
+	}
+
+INK_BITWISE_OP(InkTransparentOp, dst[i] & src[i]);
+INK_BITWISE_OP(InkNotTransOp, dst[i] & ~src[i]);
+INK_BITWISE_OP(InkReverseOp, dst[i] ^ ~src[i]);
+INK_BITWISE_OP(InkNotReverseOp, dst[i] ^ src[i]);
+INK_BITWISE_OP(InkGhostOp, dst[i] | ~src[i]);
+INK_BITWISE_OP(InkNotGhostOp, dst[i] | src[i]);
+
+#undef INK_BITWISE_OP
+
+template <typename T, typename Op>
+static void inkBlitRows(DirectorPlotData *p, const Graphics::Surface *mask, const Op &op) {
+	int w = p->destRect.width();
+
+	for (int i = 0; i < p->destRect.height(); i++, p->srcPoint.y++) {
+		T *dst = (T *)p->dst->getBasePtr(p->destRect.left, p->destRect.top + i);
+		const T *src = (const T *)p->srf->getBasePtr(p->srcPoint.x, p->srcPoint.y);
+
+		if (!mask) {
+			op.span(dst, src, w);
+			continue;
+		}
+
+		// Matte and mask inks only touch the runs where the mask is clear
+		const T *msk = (const T *)mask->getBasePtr(p->srcPoint.x, p->srcPoint.y);
+		int j = 0;
+		while (j < w) {
+			while (j < w && msk[j])
+				j++;
+			int start = j;
+			while (j < w && !msk[j])
+				j++;
+			if (j > start)
+				op.span(dst + start, src + start, j - start);
+		}
+	}
+}
+
+template <typename T>
+static bool inkBlitSpans(DirectorPlotData *p, const Graphics::Surface *mask) {
+	switch (p->ink) {
+	case kInkTypeCopy:
+	case kInkTypeMatte:
+	case kInkTypeMask:
+		inkBlitRows<T>(p, mask, InkCopyOp());
+		return true;
+	case kInkTypeBackgndTrans: {
+		InkBackgndTransOp op;
+		op.backColor = p->backColor;
+		inkBlitRows<T>(p, mask, op);
+		return true;
+	}
+	case kInkTypeTransparent:
+		inkBlitRows<T>(p, mask, InkTransparentOp());
+		return true;
+	case kInkTypeNotTrans:
+		inkBlitRows<T>(p, mask, InkNotTransOp());
+		return true;
+	case kInkTypeReverse:
+		inkBlitRows<T>(p, mask, InkReverseOp());
+		return true;
+	case kInkTypeNotReverse:
+		inkBlitRows<T>(p, mask, InkNotReverseOp());
+		return true;
+	case kInkTypeGhost:
+		inkBlitRows<T>(p, mask, InkGhostOp());
+		return true;
+	case kInkTypeNotGhost:
+		inkBlitRows<T>(p, mask, InkNotGhostOp());
+		return true;
+	default:
+		return false;
+	}
+}
+
+bool DirectorPlotData::canInkBlitSpans() {
+	// Blending, colourization and the arithmetic inks need palette
+	// lookups per pixel and stay on inkDrawPixel
+	if (ms || alpha || applyColor)
+		return false;
+
+	// Text sprites get their colours remapped by preprocessColor()
+	if (sprite == kTextSprite) {
+		switch (ink) {
+		case kInkTypeCopy:
+		case kInkTypeMatte:
+		case kInkTypeBackgndTrans:
+		case kInkTypeTransparent:
+		case kInkTypeGhost:
+			break;
+		default:
+			return false;
+		}
+	}
+
+	return true;
+}
+
 void DirectorPlotData::inkBlitSurface(Common::Rect &srcRect, const Graphics::Surface *mask) {
 	if (!srf)
 		return;
@@ -417,6 +540,18 @@ void DirectorPlotData::inkBlitSurface(Common::Rect &srcRect, const Graphics::Sur
 		applyColor = false;
 
 	srcPoint.y = abs(srcRect.top - destRect.top);
+
+	if (canInkBlitSpans()) {
+		srcPoint.x = abs(srcRect.left - destRect.left);
+		bool done;
+		if (_wm->_pixelformat.bytesPerPixel == 1)
+			done = inkBlitSpans<byte>(this, mask);
+		else
+			done = inkBlitSpans<uint32>(this, mask);
+		if (done)
+			return;
+	}
+
 	for (int i = 0; i < destRect.height(); i++, srcPoint.y++) {
 		if (_wm->_pixelformat.bytesPerPixel == 1) {
 			srcPoint.x = abs(srcRect.left - destRect.left);
@@ -188,7 +188,7 @@ void Lingo::cleanupFuncs() {
 		delete it->_value;
 }
 
-void Lingo::push(Datum d) {
+void Lingo::push(const Datum &d) {
 	_stack.push_back(d);
 }
 
@@ -202,7 +202,7 @@ void Lingo::pushVoid() {
 Datum Lingo::pop() {
 	assert (_stack.size() != 0);
 
-	Datum ret = _stack.back();
+	Datum ret(static_cast<Datum &&>(_stack.back()));
 	_stack.pop_back();
 
 	return ret;
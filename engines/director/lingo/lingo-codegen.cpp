@@ -109,11 +109,46 @@ LingoCompiler::LingoCompiler() {
 	_hadError = false;
 }
 
+LingoCompiler::~LingoCompiler() {
+	clearAnonymousCache();
+}
+
+// Upper bound on cached anonymous scripts. Scripts which build their
+// `do` strings on the fly would otherwise grow the cache forever.
+#define MAX_ANONYMOUS_CACHE 64
+
 ScriptContext *LingoCompiler::compileAnonymous(const Common::U32String &code) {
+	// Bare cast numbers are only treated as such in outdated Lingo,
+	// so that setting is part of what the code compiles to.
+	bool outdated = g_director->getVersion() < 400 || (g_director->getCurrentMovie() && g_director->getCurrentMovie()->_allowOutdatedLingo);
+	Common::String key = (outdated ? "1" : "0") + code.encode(Common::kUtf8);
+
+	if (_anonymousCache.contains(key))
+		return _anonymousCache[key];
+
 	debugC(1, kDebugCompile, "Compiling anonymous lingo\n"
 			"***********\n%s\n\n***********", code.encode().c_str());
 
-	return compileLingo(code, nullptr, kNoneScript, CastMemberID(0, 0), "[anonymous]", true);
+	ScriptContext *sc = compileLingo(code, nullptr, kNoneScript, CastMemberID(0, 0), "[anonymous]", true);
+	if (!sc)
+		return nullptr;
+
+	if (_anonymousCache.size() >= MAX_ANONYMOUS_CACHE)
+		clearAnonymousCache();
+
+	// The cache holds its own reference, running frames hold theirs
+	*sc->_refCount += 1;
+	_anonymousCache[key] = sc;
+	return sc;
+}
+
+void LingoCompiler::clearAnonymousCache() {
+	for (Common::HashMap<Common::String, ScriptContext *>::iterator it = _anonymousCache.begin(); it != _anonymousCache.end(); ++it) {
+		*it->_value->_refCount -= 1;
+		if (*it->_value->_refCount <= 0)
+			delete it->_value;
+	}
+	_anonymousCache.clear();
 }
 
 ScriptContext *LingoCompiler::compileLingo(const Common::U32String &code, LingoArchive *archive, ScriptType type, CastMemberID id, const Common::String &scriptName, bool anonymous) {
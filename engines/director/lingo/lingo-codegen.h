@@ -31,9 +31,10 @@ namespace Director {
 class LingoCompiler : NodeVisitor {
 public:
 	LingoCompiler();
-	virtual ~LingoCompiler() {}
+	virtual ~LingoCompiler();
 
 	ScriptContext *compileAnonymous(const Common::U32String &code);
+	void clearAnonymousCache();
 	ScriptContext *compileLingo(const Common::U32String &code, LingoArchive *archive, ScriptType type, CastMemberID id, const Common::String &scriptName, bool anonyomous = false);
 	ScriptContext *compileLingoV4(Common::SeekableReadStreamEndian &stream, LingoArchive *archive, const Common::String &archName, uint16 version);
 
@@ -71,6 +72,10 @@ public:
 
 	bool _hadError;
 
+	// `do` and `value` recompile the same strings over and over, keep
+	// the resulting contexts around keyed by their source
+	Common::HashMap<Common::String, ScriptContext *> _anonymousCache;
+
 public:
 	virtual bool visitScriptNode(ScriptNode *node);
 	virtual bool visitFactoryNode(FactoryNode *node);
@@ -883,6 +883,11 @@ Datum BitmapCastMember::getField(int field) {
 	case kThePicture:
 		warning("STUB: BitmapCastMember::getField(): Unprocessed getting field \"%s\" of cast %d", g_lingo->field2str(field), _castId);
 		break;
+	case kTheSize:
+		// The size is only known once the bitmap has been decoded
+		getImage();
+		d = CastMember::getField(field);
+		break;
 	default:
 		d = CastMember::getField(field);
 	}
@@ -591,47 +591,71 @@ int Lingo::getAlignedType(const Datum &d1, const Datum &d2, bool numsOnly) {
 Datum::Datum() {
 	u.s = nullptr;
 	type = VOID;
-	refCount = new int;
-	*refCount = 1;
+	refCount = nullptr;
 }
 
 Datum::Datum(const Datum &d) {
+	type = d.type;
+	u = d.u;
+	refCount = d.shareRefCount();
+}
+
+Datum::Datum(Datum &&d) {
 	type = d.type;
 	u = d.u;
 	refCount = d.refCount;
-	*refCount += 1;
+	d.type = VOID;
+	d.refCount = nullptr;
 }
 
 Datum& Datum::operator=(const Datum &d) {
-	if (this != &d && refCount != d.refCount) {
-		reset();
-		type = d.type;
-		u = d.u;
-		refCount = d.refCount;
-		*refCount += 1;
-	}
+	if (this == &d || (refCount && refCount == d.refCount))
+		return *this;
+
+	// Take the new reference before dropping the old one, d may live
+	// inside the payload we are about to free.
+	DatumType newType = d.type;
+	decltype(u) newU = d.u;
+	int *newRefCount = d.shareRefCount();
+	reset();
+	type = newType;
+	u = newU;
+	refCount = newRefCount;
+	return *this;
+}
+
+Datum& Datum::operator=(Datum &&d) {
+	if (this == &d)
+		return *this;
+
+	DatumType newType = d.type;
+	decltype(u) newU = d.u;
+	int *newRefCount = d.refCount;
+	d.type = VOID;
+	d.refCount = nullptr;
+	reset();
+	type = newType;
+	u = newU;
+	refCount = newRefCount;
 	return *this;
 }
 
 Datum::Datum(int val) {
 	u.i = val;
 	type = INT;
-	refCount = new int;
-	*refCount = 1;
+	refCount = nullptr;
 }
 
 Datum::Datum(double val) {
 	u.f = val;
 	type = FLOAT;
-	refCount = new int;
-	*refCount = 1;
+	refCount = nullptr;
 }
 
 Datum::Datum(const Common::String &val) {
 	u.s = new Common::String(val);
 	type = STRING;
-	refCount = new int;
-	*refCount = 1;
+	refCount = nullptr;
 }
 
 Datum::Datum(AbstractObject *val) {
@@ -642,16 +666,14 @@ Datum::Datum(AbstractObject *val) {
 		*refCount += 1;
 	} else {
 		type = VOID;
-		refCount = new int;
-		*refCount = 1;
+		refCount = nullptr;
 	}
 }
 
 Datum::Datum(const CastMemberID &val) {
 	u.cast = new CastMemberID(val);
 	type = CASTREF;
-	refCount = new int;
-	*refCount = 1;
+	refCount = nullptr;
 }
 
 Datum::Datum(const Common::Rect &rect) {
@@ -661,11 +683,28 @@ Datum::Datum(const Common::Rect &rect) {
 	u.farr->arr.push_back(Datum(rect.top));
 	u.farr->arr.push_back(Datum(rect.right));
 	u.farr->arr.push_back(Datum(rect.bottom));
+	refCount = nullptr;
+}
+
+int *Datum::shareRefCount() const {
+	if (!refCount) {
+		// Scalars are copied by value
+		if (!isHeapType())
+			return nullptr;
+		refCount = new int;
+		*refCount = 1;
+	}
+	*refCount += 1;
+	return refCount;
 }
 
 void Datum::reset() {
-	if (!refCount)
+	if (!refCount) {
+		// Sole owner, nobody else can see the payload
+		if (isHeapType())
+			freePayload();
 		return;
+	}
 
 	*refCount -= 1;
 	// Coverity thinks that we always free memory, as it assumes
@@ -673,48 +712,52 @@ void Datum::reset() {
 	// Thus, DO NOT COMPILE, trick it and shut tons of false positives
 #ifndef __COVERITY__
 	if (*refCount <= 0) {
-		switch (type) {
-		case VARREF:
-		case GLOBALREF:
-		case LOCALREF:
-		case PROPREF:
-		case STRING:
-		case SYMBOL:
-			delete u.s;
-			break;
-		case ARRAY:
-		case POINT:
-		case RECT:
-			delete u.farr;
-			break;
-		case PARRAY:
-			delete u.parr;
-			break;
-		case OBJECT:
-			if (u.obj->getObjType() == kWindowObj) {
-				Window *window = static_cast<Window *>(u.obj);
-				g_director->_wm->removeWindow(window);
-				g_director->_wm->removeMarked();
-			} else {
-				delete u.obj;
-			}
-			break;
-		case CHUNKREF:
-			delete u.cref;
-			break;
-		case CASTREF:
-		case FIELDREF:
-			delete u.cast;
-			break;
-		default:
-			break;
-		}
+		freePayload();
 		if (type != OBJECT) // object owns refCount
 			delete refCount;
 	}
 #endif
 }
 
+void Datum::freePayload() {
+	switch (type) {
+	case VARREF:
+	case GLOBALREF:
+	case LOCALREF:
+	case PROPREF:
+	case STRING:
+	case SYMBOL:
+		delete u.s;
+		break;
+	case ARRAY:
+	case POINT:
+	case RECT:
+		delete u.farr;
+		break;
+	case PARRAY:
+		delete u.parr;
+		break;
+	case OBJECT:
+		if (u.obj->getObjType() == kWindowObj) {
+			Window *window = static_cast<Window *>(u.obj);
+			g_director->_wm->removeWindow(window);
+			g_director->_wm->removeMarked();
+		} else {
+			delete u.obj;
+		}
+		break;
+	case CHUNKREF:
+		delete u.cref;
+		break;
+	case CASTREF:
+	case FIELDREF:
+		delete u.cast;
+		break;
+	default:
+		break;
+	}
+}
+
 Datum Datum::eval() const {
 	if (isRef()) {
 		return g_lingo->varFetch(*this);
@@ -960,6 +1003,27 @@ bool Datum::isCastRef() const {
 	return (type == CASTREF || type == FIELDREF);
 }
 
+bool Datum::isHeapType() const {
+	switch (type) {
+	case VARREF:
+	case GLOBALREF:
+	case LOCALREF:
+	case PROPREF:
+	case STRING:
+	case SYMBOL:
+	case ARRAY:
+	case POINT:
+	case RECT:
+	case PARRAY:
+	case CHUNKREF:
+	case CASTREF:
+	case FIELDREF:
+		return true;
+	default:
+		return false;
+	}
+}
+
 const char *Datum::type2str(bool isk) const {
 	static char res[20];
 
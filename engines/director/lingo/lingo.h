@@ -142,11 +142,16 @@ struct Datum {	/* interpreter stack type */
 		CastMemberID *cast;	/* CASTREF, FIELDREF */
 	} u;
 
-	int *refCount;
+	// Shared by all copies of a heap-backed Datum. Scalars never allocate
+	// one, and a heap Datum only does so once it is first copied, so a
+	// Datum with a heap type and no refCount is the sole owner of u.
+	mutable int *refCount;
 
 	Datum();
 	Datum(const Datum &d);
+	Datum(Datum &&d);
 	Datum& operator=(const Datum &d);
+	Datum& operator=(Datum &&d);
 	Datum(int val);
 	Datum(double val);
 	Datum(const Common::String &val);
@@ -169,6 +174,8 @@ struct Datum {	/* interpreter stack type */
 	bool isRef() const;
 	bool isVarRef() const;
 	bool isCastRef() const;
+	// True for types whose payload is allocated by the Datum itself
+	bool isHeapType() const;
 
 	const char *type2str(bool isk = false) const;
 
@@ -180,6 +187,10 @@ struct Datum {	/* interpreter stack type */
 	bool operator<(Datum &d) const;
 	bool operator>=(Datum &d) const;
 	bool operator<=(Datum &d) const;
+
+private:
+	int *shareRefCount() const;
+	void freePayload();
 };
 
 struct ChunkReference {
@@ -431,7 +442,7 @@ public:
 	Common::String _floatPrecisionFormat;
 
 public:
-	void push(Datum d);
+	void push(const Datum &d);
 	Datum pop();
 	Datum peek(uint offset);
 
@@ -166,16 +166,13 @@ void Window::playTransition(uint16 transDuration, uint8 transArea, uint8 transCh
 		// Changed area transition
 		g_director->getCurrentMovie()->getScore()->renderSprites(t.frame);
 
-		if (_dirtyRects.size() == 0)
+		if (_dirtyRegion.isEmpty())
 			return;
 
-		clipRect = *_dirtyRects.begin();
-
-		for (Common::List<Common::Rect>::iterator i = _dirtyRects.begin(); i != _dirtyRects.end(); ++i)
-			clipRect.extend(*i);
+		clipRect = _dirtyRegion.getBounds();
 
 		// Ensure we redraw any other sprites intersecting the non-clip area.
-		_dirtyRects.clear();
+		_dirtyRegion.clear();
 
 		// Some transitions depend upon an even clipRect size
 		if (clipRect.width() % 2 == 1)
@@ -185,7 +182,7 @@ void Window::playTransition(uint16 transDuration, uint8 transArea, uint8 transCh
 			clipRect.bottom += 1;
 
 		clipRect.clip(Common::Rect(_innerDims.width(), _innerDims.height()));
-		_dirtyRects.push_back(clipRect);
+		_dirtyRegion.unite(clipRect);
 
 		render(false, &nextFrame);
 	} else {
@@ -124,38 +124,73 @@ bool Window::render(bool forceRedraw, Graphics::ManagedSurface *blitTo) {
 		blitTo->clear(_stageColor);
 		markAllDirty();
 	} else {
-		if (_dirtyRects.size() == 0 && _currentMovie->_videoPlayback == false)
+		if (_dirtyRegion.isEmpty() && _currentMovie->_videoPlayback == false)
 			return false;
-
-		mergeDirtyRects();
 	}
 
 	if (!blitTo)
 		blitTo = _composeSurface;
-	Channel *hiliteChannel = _currentMovie->getScore()->getChannelById(_currentMovie->_currentHiliteChannelId);
+	Score *score = _currentMovie->getScore();
+	Channel *hiliteChannel = score->getChannelById(_currentMovie->_currentHiliteChannelId);
+
+	// Trail sprites are drawn over the previous frame instead of a cleared
+	// stage, as long as nothing around them got dirty as well
+	Common::Region trailRegion;
+	Common::List<Channel *> candidates = score->getSpriteIntersections(_dirtyRegion.getBounds());
+	for (Common::List<Channel *>::iterator j = candidates.begin(); j != candidates.end(); j++) {
+		if (!(*j)->_visible || !(*j)->isTrail())
+			continue;
+
+		Common::Rect bbox = (*j)->getBbox();
+		if (!_dirtyRegion.contains(bbox))
+			continue;
+
+		Common::Region around(_dirtyRegion);
+		around.subtract(bbox);
+		bbox.grow(1);
+		if (!around.intersects(bbox))
+			trailRegion.unite((*j)->getBbox());
+	}
 
-	for (Common::List<Common::Rect>::iterator i = _dirtyRects.begin(); i != _dirtyRects.end(); i++) {
+	// The region never overlaps itself, so every pixel is composited once
+	for (Common::Region::const_iterator i = _dirtyRegion.begin(); i != _dirtyRegion.end(); i++) {
 		const Common::Rect &r = *i;
-		_dirtyChannels = _currentMovie->getScore()->getSpriteIntersections(r);
+		_dirtyChannels = score->getSpriteIntersections(r);
 
-		bool shouldClear = true;
+		// Nothing below the topmost opaque sprite covering the whole rect
+		// can show through, so start drawing from there
+		Common::List<Channel *>::iterator firstVisible = _dirtyChannels.begin();
+		bool covered = false;
 		for (Common::List<Channel *>::iterator j = _dirtyChannels.begin(); j != _dirtyChannels.end(); j++) {
-			if ((*j)->_visible && r == (*j)->getBbox() && (*j)->isTrail()) {
-				shouldClear = false;
-				break;
+			if ((*j)->isOpaque() && (*j)->getBbox().contains(r)) {
+				firstVisible = j;
+				covered = true;
 			}
 		}
 
-		if (shouldClear)
-			blitTo->fillRect(r, _stageColor);
+		if (!covered) {
+			if (trailRegion.intersects(r)) {
+				Common::Region clearRegion(r);
+				clearRegion.subtract(trailRegion);
+				for (Common::Region::const_iterator k = clearRegion.begin(); k != clearRegion.end(); k++)
+					blitTo->fillRect(*k, _stageColor);
+			} else {
+				blitTo->fillRect(r, _stageColor);
+			}
+		}
 
 		for (int pass = 0; pass < 2; pass++) {
+			bool hidden = covered;
 			for (Common::List<Channel *>::iterator j = _dirtyChannels.begin(); j != _dirtyChannels.end(); j++) {
+				if (j == firstVisible)
+					hidden = false;
+
 				if ((*j)->isActiveVideo() && (*j)->isVideoDirectToStage()) {
+					// Drawn on top of everything else, even if under an opaque sprite
 					if (pass == 0)
 						continue;
 				} else {
-					if (pass == 1)
+					if (pass == 1 || hidden)
 						continue;
 				}
 
@@ -175,7 +210,7 @@ bool Window::render(bool forceRedraw, Graphics::ManagedSurface *blitTo) {
 		}
 	}
 
-	_dirtyRects.clear();
+	_dirtyRegion.clear();
 	_contentIsDirty = true;
 
 	return true;
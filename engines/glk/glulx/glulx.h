@@ -161,6 +161,19 @@ private:
 	int undo_chain_num;
 	byte **undo_chain;
 
+	/**
+	 * Total size of the undo chain records, which are trimmed to stay within UNDO_MEMORY_BUDGET
+	 */
+	uint undo_chain_bytes;
+
+	/**
+	 * Copy of RAM as of the newest undo state. Each undo record holds the difference
+	 * between its state and the one before it, so this is walked back as states are restored.
+	 * Bytes past undo_base_len up to undo_base_size are kept zeroed
+	 */
+	byte *undo_base;
+	uint undo_base_len, undo_base_size;
+
 	/**
 	 * This will contain a copy of RAM (ramstate to endmem) as it exists in the game file.
 	 */
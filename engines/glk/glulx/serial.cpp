@@ -20,6 +20,7 @@
  */
 
 #include "glk/glulx/glulx.h"
+#include "glk/mem_diff.h"
 
 namespace Glk {
 namespace Glulx {
@@ -62,6 +63,14 @@ void Glulx::final_serial() {
 	undo_chain = nullptr;
 	undo_chain_size = 0;
 	undo_chain_num = 0;
+	undo_chain_bytes = 0;
+
+	if (undo_base) {
+		glulx_free(undo_base);
+		undo_base = nullptr;
+	}
+	undo_base_len = 0;
+	undo_base_size = 0;
 
 #ifdef SERIALIZE_CACHE_RAM
 	if (ramcache) {
@@ -74,28 +83,70 @@ void Glulx::final_serial() {
 uint Glulx::perform_saveundo() {
 	dest_t dest;
 	uint res;
-	uint memstart = 0, memlen = 0, heapstart = 0, heaplen = 0;
+	uint ramlen, len, difflen = 0, reclen = 0;
+	uint heapstart = 0, heaplen = 0;
 	uint stackstart = 0, stacklen = 0;
+	const byte *ram;
+	byte *padded = nullptr;
+	bool diffed = false;
 
 	/* The format for undo-saves is simpler than for saves on disk. We
-	   just have a memory chunk, a heap chunk, and a stack chunk, in
-	   that order. We skip the IFF chunk headers (although the size
-	   fields are still there.) We also don't bother with IFF's 16-bit
-	   alignment. */
+	   have a header giving the record length, the RAM length of this
+	   state and of the state before it, and the length of the memory
+	   difference between the two. Then the memory difference, a heap
+	   chunk, and a stack chunk, in that order. We skip the IFF chunk
+	   headers (although the size fields are still there.) We also don't
+	   bother with IFF's 16-bit alignment.
+
+	   Memory isn't compared against the game file as it is for saves on
+	   disk, but against the previous undo state kept in undo_base. Most
+	   turns only touch a handful of bytes, so the records stay small. */
 
 	if (undo_chain_size == 0)
 		return 1;
 
+	ramlen = endmem - ramstart;
+	len = MAX(ramlen, undo_base_len);
+	if (len > undo_base_size) {
+		byte *newbase = (byte *)glulx_realloc(undo_base, len);
+		if (!newbase)
+			return 1;
+		memset(newbase + undo_base_size, 0, len - undo_base_size);
+		undo_base = newbase;
+		undo_base_size = len;
+	}
+
+	ram = memmap + ramstart;
+	if (ramlen < len) {
+		/* Memory has shrunk since the last state, so compare the previous
+		   state against the current memory padded out with zeroes. */
+		padded = (byte *)glulx_malloc(len);
+		if (!padded)
+			return 1;
+		memcpy(padded, ram, ramlen);
+		memset(padded + ramlen, 0, len - ramlen);
+		ram = padded;
+	}
+
 	dest._isMem = true;
+	dest._size = 16 + memDiffMaxSize(len);
+	dest._ptr = (byte *)glulx_malloc(dest._size);
 
-	res = 0;
+	res = dest._ptr ? 0 : 1;
 	if (res == 0) {
-		res = write_long(&dest, 0); /* space for chunk length */
+		difflen = memDiff(ram, undo_base, len, dest._ptr + 16);
+		diffed = true;
+		res = write_long(&dest, 0); /* space for record length */
 	}
 	if (res == 0) {
-		memstart = dest._pos;
-		res = write_memstate(&dest);
-		memlen = dest._pos - memstart;
+		res = write_long(&dest, ramlen);
+	}
+	if (res == 0) {
+		res = write_long(&dest, undo_base_len);
+	}
+	if (res == 0) {
+		res = write_long(&dest, difflen);
+		dest._pos += difflen;
 	}
 	if (res == 0) {
 		res = write_long(&dest, 0); /* space for chunk length */
@@ -116,15 +167,18 @@ uint Glulx::perform_saveundo() {
 
 	if (res == 0) {
 		/* Trim it down to the perfect size. */
-		dest._ptr = (byte *)glulx_realloc(dest._ptr, dest._pos);
-		if (!dest._ptr)
+		reclen = dest._pos;
+		byte *newptr = (byte *)glulx_realloc(dest._ptr, reclen);
+		if (newptr)
+			dest._ptr = newptr;
+		else
 			res = 1;
 	}
 	if (res == 0) {
-		res = reposition_write(&dest, memstart - 4);
+		res = reposition_write(&dest, 0);
 	}
 	if (res == 0) {
-		res = write_long(&dest, memlen);
+		res = write_long(&dest, reclen);
 	}
 	if (res == 0) {
 		res = reposition_write(&dest, heapstart - 4);
@@ -139,9 +193,13 @@ uint Glulx::perform_saveundo() {
 		res = write_long(&dest, stacklen);
 	}
 
+	if (padded)
+		glulx_free(padded);
+
 	if (res == 0) {
 		/* It worked. */
 		if (undo_chain_num >= undo_chain_size) {
+			undo_chain_bytes -= Read4(undo_chain[undo_chain_num - 1]);
 			glulx_free(undo_chain[undo_chain_num - 1]);
 			undo_chain[undo_chain_num - 1] = nullptr;
 		}
@@ -151,9 +209,35 @@ uint Glulx::perform_saveundo() {
 		undo_chain[0] = dest._ptr;
 		if (undo_chain_num < undo_chain_size)
 			undo_chain_num += 1;
+		undo_chain_bytes += reclen;
 		dest._ptr = nullptr;
+
+		/* Drop the oldest states once they take up too much memory. The
+		   newest record is always kept. */
+		while (undo_chain_bytes > UNDO_MEMORY_BUDGET && undo_chain_num > 1) {
+			undo_chain_num -= 1;
+			undo_chain_bytes -= Read4(undo_chain[undo_chain_num]);
+			glulx_free(undo_chain[undo_chain_num]);
+			undo_chain[undo_chain_num] = nullptr;
+		}
+
+		undo_base_len = ramlen;
 	} else {
 		/* It didn't work. */
+		if (diffed && dest._ptr) {
+			/* Put the previous state back. */
+			memUndiff(dest._ptr + 16, difflen, undo_base);
+		} else if (diffed) {
+			/* The difference was lost along with the record, so the older
+			   records no longer lead anywhere. */
+			while (undo_chain_num > 0) {
+				undo_chain_num -= 1;
+				glulx_free(undo_chain[undo_chain_num]);
+				undo_chain[undo_chain_num] = nullptr;
+			}
+			undo_chain_bytes = 0;
+			undo_base_len = ramlen;
+		}
 		if (dest._ptr) {
 			glulx_free(dest._ptr);
 			dest._ptr = nullptr;
@@ -166,6 +250,8 @@ uint Glulx::perform_saveundo() {
 uint Glulx::perform_restoreundo() {
 	dest_t dest;
 	uint res, val = 0;
+	uint reclen = 0, ramlen = 0, prevlen = 0, difflen = 0, diffstart = 0;
+	uint pos, next;
 	uint heapsumlen = 0;
 	uint *heapsumarr = nullptr;
 
@@ -183,10 +269,34 @@ uint Glulx::perform_restoreundo() {
 
 	res = 0;
 	if (res == 0) {
-		res = read_long(&dest, &val);
+		res = read_long(&dest, &reclen);
+	}
+	if (res == 0) {
+		res = read_long(&dest, &ramlen);
+	}
+	if (res == 0) {
+		res = read_long(&dest, &prevlen);
+	}
+	if (res == 0) {
+		res = read_long(&dest, &difflen);
+		diffstart = dest._pos;
+		dest._pos += difflen;
 	}
 	if (res == 0) {
-		res = read_memstate(&dest, val);
+		heap_clear();
+		res = change_memsize(ramstart + ramlen, false);
+	}
+	if (res == 0) {
+		/* The newest state is the one held in full, so RAM is copied straight
+		   out of it, leaving the protected range alone. */
+		for (pos = ramstart; pos < endmem; pos = next) {
+			if (pos >= protectstart && pos < protectend) {
+				next = MIN(protectend, endmem);
+				continue;
+			}
+			next = (protectstart > pos && protectstart < endmem) ? protectstart : endmem;
+			memcpy(memmap + pos, undo_base + (pos - ramstart), next - pos);
+		}
 	}
 	if (res == 0) {
 		res = read_long(&dest, &val);
@@ -209,11 +319,17 @@ uint Glulx::perform_restoreundo() {
 	}
 
 	if (res == 0) {
-		/* It worked. */
+		/* It worked. Step the copy of RAM back to the state before this one;
+		   the buffer already covers both lengths, since it was sized for
+		   them when this record was saved. */
+		memUndiff(dest._ptr + diffstart, difflen, undo_base);
+		undo_base_len = prevlen;
+
 		if (undo_chain_size > 1)
 			memmove(undo_chain, undo_chain + 1,
 			        (undo_chain_size - 1) * sizeof(unsigned char *));
 		undo_chain_num -= 1;
+		undo_chain_bytes -= reclen;
 		glulx_free(dest._ptr);
 		dest._ptr = nullptr;
 	} else {
@@ -0,0 +1,92 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "glk/mem_diff.h"
+
+namespace Glk {
+
+uint32 memDiff(const byte *a, byte *b, uint32 size, byte *diff) {
+	byte *p = diff;
+	uint32 j;
+	byte c = 0;
+
+	for (;;) {
+		for (j = 0; size > 0 && (c = *a++ ^ *b++) == 0; j++)
+			size--;
+		if (size == 0)
+			break;
+		size--;
+
+		// Runs are stored as a zero byte followed by the run length minus one,
+		// in one byte, or in two for lengths up to 0x8000
+		while (j > 0x8000) {
+			*p++ = 0;
+			*p++ = 0xff;
+			*p++ = 0xff;
+			j -= 0x8000;
+		}
+		if (j > 0) {
+			*p++ = 0;
+			j--;
+			if (j <= 0x7f) {
+				*p++ = j;
+			} else {
+				*p++ = (j & 0x7f) | 0x80;
+				*p++ = (j & 0x7f80) >> 7;
+			}
+		}
+
+		*p++ = c;
+		*(b - 1) ^= c;
+	}
+
+	return p - diff;
+}
+
+void memUndiff(const byte *diff, uint32 diffLength, byte *dest) {
+	byte c;
+
+	while (diffLength) {
+		c = *diff++;
+		diffLength--;
+		if (c == 0) {
+			uint runlen;
+
+			if (!diffLength)
+				return;  // Incomplete run
+			runlen = *diff++;
+			diffLength--;
+			if (runlen & 0x80) {
+				if (!diffLength)
+					return; // Incomplete extended run
+				c = *diff++;
+				diffLength--;
+				runlen = (runlen & 0x7f) | (((uint)c) << 7);
+			}
+
+			dest += runlen + 1;
+		} else {
+			*dest++ ^= c;
+		}
+	}
+}
+
+} // End of namespace Glk
@@ -0,0 +1,61 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef GLK_MEM_DIFF_H
+#define GLK_MEM_DIFF_H
+
+#include "common/scummsys.h"
+
+namespace Glk {
+
+/**
+ * Total size the interpreters allow their undo states to take up. Once it is
+ * exceeded the oldest states are dropped, though the newest is always kept
+ */
+#define UNDO_MEMORY_BUDGET (4 * 1024 * 1024)
+
+/**
+ * Returns the largest number of bytes memDiff can produce for a block of the given size
+ */
+inline uint32 memDiffMaxSize(uint32 size) {
+	return size + size / 2 + 3;
+}
+
+/**
+ * Computes the difference between two memory blocks as XORed bytes, with unchanged
+ * stretches stored as runs. Afterwards b holds a copy of a.
+ * @param a			Current memory
+ * @param b			Previous memory, updated to the current memory
+ * @param size		Size of both blocks
+ * @param diff		Output buffer, at least memDiffMaxSize(size) bytes
+ * @returns			Number of bytes written to diff
+ */
+uint32 memDiff(const byte *a, byte *b, uint32 size, byte *diff);
+
+/**
+ * Applies a difference produced by memDiff, turning the memory it was made
+ * against into the memory that was current at the time, or the other way around
+ */
+void memUndiff(const byte *diff, uint32 diffLength, byte *dest);
+
+} // End of namespace Glk
+
+#endif
@@ -9,6 +9,7 @@ MODULE_OBJS := \
 	glk.o \
 	glk_api.o \
 	glk_dispa.o \
+	mem_diff.o \
 	metaengine.o \
 	pc_speaker.o \
 	picture.o \
@@ -29,7 +29,7 @@ namespace ZCode {
 
 Mem::Mem() : story_fp(nullptr), story_size(0), first_undo(nullptr), last_undo(nullptr),
 		curr_undo(nullptr), undo_mem(nullptr), zmp(nullptr), pcp(nullptr), prev_zmp(nullptr),
-		undo_diff(nullptr), undo_count(0), reserve_mem(0) {
+		undo_diff(nullptr), undo_count(0), undo_bytes(0), reserve_mem(0) {
 }
 
 void Mem::initialize() {
@@ -97,8 +97,8 @@ void Mem::initializeUndo() {
 	}
 
 	// Allocate h_dynamic_size bytes for previous dynamic zmp state
-	// + 1.5 h_dynamic_size for Quetzal diff + 2.
-	undo_mem = new zbyte[(h_dynamic_size * 5) / 2 + 2];
+	// + 1.5 h_dynamic_size for Quetzal diff + 3.
+	undo_mem = new zbyte[h_dynamic_size + memDiffMaxSize(h_dynamic_size)];
 	if (undo_mem != nullptr) {
 		prev_zmp = undo_mem;
 		undo_diff = undo_mem + h_dynamic_size;
@@ -219,6 +219,7 @@ void Mem::free_undo(int count) {
 		if (curr_undo == first_undo)
 			curr_undo = curr_undo->next;
 		first_undo = first_undo->next;
+		undo_bytes -= sizeof(undo_t) + p->diff_size + p->stack_size * sizeof(zword);
 		free(p);
 		undo_count--;
 	}
@@ -238,72 +239,10 @@ void Mem::reset_memory() {
 
 	undo_mem = nullptr;
 	undo_count = 0;
+	undo_bytes = 0;
 	free(zmp);
 	zmp = nullptr;
 }
 
-long Mem::mem_diff(zbyte *a, zbyte *b, zword mem_size, zbyte *diff) {
-	unsigned size = mem_size;
-	zbyte *p = diff;
-	unsigned j;
-	zbyte c = 0;
-
-	for (;;) {
-		for (j = 0; size > 0 && (c = *a++ ^ *b++) == 0; j++)
-			size--;
-		if (size == 0) break;
-		size--;
-		if (j > 0x8000) {
-			*p++ = 0;
-			*p++ = 0xff;
-			*p++ = 0xff;
-			j -= 0x8000;
-		}
-		if (j > 0) {
-			*p++ = 0;
-			j--;
-			if (j <= 0x7f) {
-				*p++ = j;
-			} else {
-				*p++ = (j & 0x7f) | 0x80;
-				*p++ = (j & 0x7f80) >> 7;
-			}
-		}
-
-		*p++ = c;
-		*(b - 1) ^= c;
-	}
-
-	return p - diff;
-}
-
-void Mem::mem_undiff(zbyte *diff, long diff_length, zbyte *dest) {
-	zbyte c;
-
-	while (diff_length) {
-		c = *diff++;
-		diff_length--;
-		if (c == 0) {
-			unsigned runlen;
-
-			if (!diff_length)
-				return;  // Incomplete run
-			runlen = *diff++;
-			diff_length--;
-			if (runlen & 0x80) {
-				if (!diff_length)
-					return; // Incomplete extended run
-				c = *diff++;
-				diff_length--;
-				runlen = (runlen & 0x7f) | (((unsigned)c) << 7);
-			}
-
-			dest += runlen + 1;
-		} else {
-			*dest++ ^= c;
-		}
-	}
-}
-
 } // End of namespace ZCode
 } // End of namespace Glk
@@ -24,6 +24,7 @@
 
 #include "glk/zcode/frotz_types.h"
 #include "glk/zcode/config.h"
+#include "glk/mem_diff.h"
 
 namespace Glk {
 namespace ZCode {
@@ -65,6 +66,7 @@ protected:
 	undo_t *first_undo, *last_undo, *curr_undo;
 	zbyte *undo_mem, *prev_zmp, *undo_diff;
 	int undo_count;
+	long undo_bytes;
 	int reserve_mem;
 private:
 	/**
@@ -131,21 +133,6 @@ protected:
 	 * Close the story file and deallocate memory.
 	 */
 	void reset_memory();
-
-	/**
-	 * Set diff to a Quetzal-like difference between a and b,
-	 * copying a to b as we go.  It is assumed that diff points to a
-	 * buffer which is large enough to hold the diff.
-	 * mem_size is the number of bytes to compare.
-	 * Returns the number of bytes copied to diff.
-	 *
-	 */
-	long mem_diff(zbyte *a, zbyte *b, zword mem_size, zbyte *diff);
-
-	/**
-	 * Applies a quetzal-like diff to dest
-	 */
-	void mem_undiff(zbyte *diff, long diff_length, zbyte *dest);
 public:
 	/**
 	 * Constructor
@@ -47,7 +47,8 @@ int Processor::save_undo() {
 	while (last_undo != curr_undo) {
 		p = last_undo;
 		last_undo = last_undo->prev;
-		delete p;
+		undo_bytes -= sizeof(undo_t) + p->diff_size + p->stack_size * sizeof(*_sp);
+		free(p);
 		undo_count--;
 	}
 	if (last_undo)
@@ -58,7 +59,7 @@ int Processor::save_undo() {
 	if (undo_count == _undo_slots)
 		free_undo(1);
 
-	diff_size = mem_diff(zmp, prev_zmp, h_dynamic_size, undo_diff);
+	diff_size = memDiff(zmp, prev_zmp, h_dynamic_size, undo_diff);
 	stack_size = _stack + STACK_SIZE - _sp;
 	do {
 		p = (undo_t *) malloc(sizeof(undo_t) + diff_size + stack_size * sizeof(*_sp));
@@ -87,6 +88,11 @@ int Processor::save_undo() {
 	p->next = nullptr;
 	curr_undo = last_undo = p;
 	undo_count++;
+	undo_bytes += sizeof(undo_t) + diff_size + stack_size * sizeof(*_sp);
+
+	// Drop the oldest states once they take up too much memory
+	while (undo_bytes > UNDO_MEMORY_BUDGET && undo_count > 1)
+		free_undo(1);
 
 	return 1;
 }
@@ -106,7 +112,7 @@ int Processor::restore_undo(void) {
 	_sp = _stack + STACK_SIZE - curr_undo->stack_size;
 	_fp = _stack + curr_undo->frame_offset;
 	_frameCount = curr_undo->frame_count;
-	mem_undiff((zbyte *)(curr_undo + 1), curr_undo->diff_size, prev_zmp);
+	memUndiff((zbyte *)(curr_undo + 1), curr_undo->diff_size, prev_zmp);
 	memcpy(_sp, (zbyte *)(curr_undo + 1) + curr_undo->diff_size,
 		curr_undo->stack_size * sizeof(*_sp));
 
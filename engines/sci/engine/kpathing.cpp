@@ -116,10 +116,14 @@ struct Vertex {
 	// Previous vertex in shortest path
 	Vertex *path_prev;
 
+	// Position in the vertex index of the pathfinding state
+	int index;
+
 public:
 	Vertex(const Common::Point &p) : v(p) {
 		costG = HUGE_DISTANCE;
 		path_prev = nullptr;
+		index = -1;
 	}
 };
 
@@ -262,6 +266,16 @@ struct PathfindingState {
 	// Screen size
 	int _width, _height;
 
+	// Number of single-vertex polygons added in front of the obstacle
+	// polygons for the start and end points
+	int _extraVertices;
+
+	// Set if the start or end point was merged by splitting a polygon edge
+	bool _edgeSplit;
+
+	// Visibility cache for the obstacle polygons, or NULL if it can't be used
+	AvoidPathCache *_cache;
+
 	PathfindingState(int width, int height) : _width(width), _height(height) {
 		vertex_start = nullptr;
 		vertex_end = nullptr;
@@ -269,6 +283,9 @@ struct PathfindingState {
 		_prependPoint = nullptr;
 		_appendPoint = nullptr;
 		vertices = 0;
+		_extraVertices = 0;
+		_edgeSplit = false;
+		_cache = nullptr;
 	}
 
 	~PathfindingState() {
@@ -698,6 +715,53 @@ static int inside(const Common::Point &p, Vertex *vertex) {
 	return 0;
 }
 
+/**
+ * Determines whether or not a vertex is visible from another vertex. The
+ * result does not depend on the order of the two vertices.
+ * @param s				the pathfinding state
+ * @param vertex_cur	the vertex to look from
+ * @param vertex		the vertex to look at
+ * @return true if vertex is visible from vertex_cur, false otherwise
+ */
+static bool vertex_visible(PathfindingState *s, Vertex *vertex_cur, Vertex *vertex) {
+	// Make sure we don't intersect a polygon locally at the vertices
+	if ((vertex == vertex_cur) || (inside(vertex->v, vertex_cur)) || (inside(vertex_cur->v, vertex)))
+		return false;
+
+	const Common::Point &a = vertex_cur->v;
+	const Common::Point &b = vertex->v;
+	const int16 minX = MIN(a.x, b.x), maxX = MAX(a.x, b.x);
+	const int16 minY = MIN(a.y, b.y), maxY = MAX(a.y, b.y);
+
+	// Check for intersecting edges
+	for (int j = 0; j < s->vertices; j++) {
+		Vertex *edge = s->vertex_index[j];
+		if (VERTEX_HAS_EDGES(edge)) {
+			const Common::Point &c = edge->v;
+			const Common::Point &d = CLIST_NEXT(edge)->v;
+
+			// An edge outside the bounding box of the line of sight can
+			// neither touch nor properly intersect it
+			if (MAX(c.x, d.x) < minX || MIN(c.x, d.x) > maxX || MAX(c.y, d.y) < minY || MIN(c.y, d.y) > maxY)
+				continue;
+
+			if (between(a, b, c)) {
+				// If we hit a vertex, make sure we can pass through it without intersecting its polygon
+				if ((inside(a, edge)) || (inside(b, edge)))
+					return false;
+
+				// This edge won't properly intersect, so we continue
+				continue;
+			}
+
+			if (intersect_proper(a, b, c, d))
+				return false;
+		}
+	}
+
+	return true;
+}
+
 /**
  * Returns a list of all vertices that are visible from a particular vertex.
  * @param s				the pathfinding state
@@ -710,36 +774,101 @@ static VertexList *visible_vertices(PathfindingState *s, Vertex *vertex_cur) {
 	for (int i = 0; i < s->vertices; i++) {
 		Vertex *vertex = s->vertex_index[i];
 
-		// Make sure we don't intersect a polygon locally at the vertices
-		if ((vertex == vertex_cur) || (inside(vertex->v, vertex_cur)) || (inside(vertex_cur->v, vertex)))
-			continue;
+		if (vertex_visible(s, vertex_cur, vertex))
+			visVerts->push_front(vertex);
+	}
 
-		// Check for intersecting edges
-		int j;
-		for (j = 0; j < s->vertices; j++) {
-			Vertex *edge = s->vertex_index[j];
-			if (VERTEX_HAS_EDGES(edge)) {
-				if (between(vertex_cur->v, vertex->v, edge->v)) {
-					// If we hit a vertex, make sure we can pass through it without intersecting its polygon
-					if ((inside(vertex_cur->v, edge)) || (inside(vertex->v, edge)))
-						break;
+	return visVerts;
+}
 
-					// This edge won't properly intersect, so we continue
-					continue;
-				}
+/**
+ * Returns a list of all vertices that are visible from a particular vertex,
+ * in the same order as visible_vertices(). Visibility between two vertices of
+ * the obstacle polygons is looked up in the visibility cache, and computed
+ * and stored there on first use. Only visibility to the start and end points
+ * is recomputed on every call.
+ * @param s				the pathfinding state
+ * @param vertex_cur	the vertex
+ * @return list of vertices that are visible from vert
+ */
+static VertexList *cached_visible_vertices(PathfindingState *s, Vertex *vertex_cur) {
+	AvoidPathCache *cache = s->_cache;
 
-				if (intersect_proper(vertex_cur->v, vertex->v, edge->v, CLIST_NEXT(edge)->v))
-					break;
-			}
+	if (!cache || vertex_cur->index < s->_extraVertices)
+		return visible_vertices(s, vertex_cur);
+
+	const int extraCount = s->_extraVertices;
+	const int cacheIndex = vertex_cur->index - extraCount;
+	Common::Array<uint16> &visible = cache->visibleVertices[cacheIndex];
+
+	if (cache->computed[cacheIndex]) {
+		++cache->vertexHits;
+	} else {
+		++cache->vertexMisses;
+		visible.clear();
+		for (int i = extraCount; i < s->vertices; i++) {
+			if (vertex_visible(s, vertex_cur, s->vertex_index[i]))
+				visible.push_back(i - extraCount);
 		}
+		cache->computed[cacheIndex] = true;
+	}
 
-		if (j == s->vertices)
+	// Build the list in descending vertex index order, like visible_vertices()
+	VertexList *visVerts = new VertexList();
+
+	for (int i = 0; i < extraCount; i++) {
+		Vertex *vertex = s->vertex_index[i];
+		if (vertex_visible(s, vertex_cur, vertex))
 			visVerts->push_front(vertex);
 	}
 
+	for (uint i = 0; i < visible.size(); i++)
+		visVerts->push_front(s->vertex_index[visible[i] + extraCount]);
+
 	return visVerts;
 }
 
+/**
+ * Points the pathfinding state at the visibility cache for its current
+ * obstacle polygons, resetting the cache if the polygons differ from the ones
+ * it was built for. Must be called before the start and end points are merged
+ * into the polygon set.
+ * @param s				the pathfinding state
+ * @param cache			the visibility cache
+ * @param opt			the optimization level
+ */
+static void attach_visibility_cache(PathfindingState *s, AvoidPathCache *cache, int opt) {
+	Common::Array<int16> key;
+	int count = 0;
+
+	key.push_back(opt);
+	for (PolygonList::iterator it = s->polygons.begin(); it != s->polygons.end(); ++it) {
+		Polygon *polygon = *it;
+		Vertex *vertex;
+
+		key.push_back((int16)polygon->type);
+		key.push_back((int16)polygon->vertices.size());
+		CLIST_FOREACH(vertex, &polygon->vertices) {
+			key.push_back(vertex->v.x);
+			key.push_back(vertex->v.y);
+			++count;
+		}
+	}
+
+	if (key == cache->key) {
+		++cache->polygonSetHits;
+	} else {
+		++cache->polygonSetMisses;
+		cache->key = key;
+		cache->computed.clear();
+		cache->computed.resize(count);
+		cache->visibleVertices.clear();
+		cache->visibleVertices.resize(count);
+	}
+
+	s->_cache = cache;
+}
+
 /**
  * Determines if a point lies on the screen border
  * Parameters: (const Common::Point &) p: The point
@@ -1146,6 +1275,7 @@ static Vertex *merge_point(PathfindingState *s, const Common::Point &v) {
 				if (between(vertex->v, next->v, v)) {
 					// Split edge by adding vertex
 					polygon->vertices.insertAfter(vertex, v_new);
+					s->_edgeSplit = true;
 					return v_new;
 				}
 			}
@@ -1156,6 +1286,7 @@ static Vertex *merge_point(PathfindingState *s, const Common::Point &v) {
 	polygon = new Polygon(POLY_BARRED_ACCESS);
 	polygon->vertices.insertHead(v_new);
 	s->polygons.push_front(polygon);
+	++s->_extraVertices;
 
 	return v_new;
 }
@@ -1339,6 +1470,8 @@ static PathfindingState *convert_polygon_set(EngineState *s, reg_t poly_list, Co
 		}
 	}
 
+	attach_visibility_cache(pf_s, &s->_avoidPathCache, opt);
+
 	// Merge start and end points into polygon set
 	pf_s->vertex_start = merge_point(pf_s, *new_start);
 	pf_s->vertex_end = merge_point(pf_s, *new_end);
@@ -1346,6 +1479,11 @@ static PathfindingState *convert_polygon_set(EngineState *s, reg_t poly_list, Co
 	delete new_start;
 	delete new_end;
 
+	// Splitting an edge changes the obstacles, so the cached visibility
+	// between their vertices no longer applies
+	if (pf_s->_edgeSplit)
+		pf_s->_cache = nullptr;
+
 	// Allocate and build vertex index
 	pf_s->vertex_index = (Vertex**)malloc(sizeof(Vertex *) * (count + 2));
 
@@ -1356,6 +1494,7 @@ static PathfindingState *convert_polygon_set(EngineState *s, reg_t poly_list, Co
 		Vertex *vertex;
 
 		CLIST_FOREACH(vertex, &polygon->vertices) {
+			vertex->index = count;
 			pf_s->vertex_index[count++] = vertex;
 		}
 	}
@@ -1408,7 +1547,7 @@ static void AStar(PathfindingState *s) {
 		closedSet.push_front(vertex_min);
 		openSet.erase(vertex_min_it);
 
-		VertexList *visVerts = visible_vertices(s, vertex_min);
+		VertexList *visVerts = cached_visible_vertices(s, vertex_min);
 
 		for (VertexList::iterator it = visVerts->begin(); it != visVerts->end(); ++it) {
 			uint32 new_dist;
@@ -1644,6 +1783,11 @@ reg_t kAvoidPath(EngineState *s, int argc, reg_t *argv) {
 		// Apply Dijkstra
 		AStar(p);
 
+		const AvoidPathCache &cache = s->_avoidPathCache;
+		debugC(kDebugLevelAvoidPath, "[avoidpath] Visibility cache: %u/%u polygon set hits, %u/%u vertex hits",
+			cache.polygonSetHits, cache.polygonSetHits + cache.polygonSetMisses,
+			cache.vertexHits, cache.vertexHits + cache.vertexMisses);
+
 		output = output_path(p, s);
 		delete p;
 
@@ -97,6 +97,22 @@ struct SciCallOrigin {
 	}
 };
 
+/**
+ * Visibility graph between the vertices of the last set of obstacle polygons
+ * used by kAvoidPath. Entries are computed lazily when the pathfinder first
+ * expands a vertex, and are reused for as long as scripts keep passing the
+ * same polygons.
+ */
+struct AvoidPathCache {
+	Common::Array<int16> key; //< Optimization level, polygon types and vertices identifying the polygon set
+	Common::Array<bool> computed; //< Whether the visible vertices of each vertex are known
+	Common::Array<Common::Array<uint16> > visibleVertices; //< Indexes of the vertices visible from each vertex, in ascending order
+	uint32 polygonSetHits, polygonSetMisses;
+	uint32 vertexHits, vertexMisses;
+
+	AvoidPathCache() : polygonSetHits(0), polygonSetMisses(0), vertexHits(0), vertexMisses(0) {}
+};
+
 struct EngineState : public Common::Serializable {
 public:
 	EngineState(SegManager *segMan);
@@ -197,6 +213,8 @@ public:
 
 	MessageState *_msgState;
 
+	AvoidPathCache _avoidPathCache;
+
 	// MemorySegment provides access to a 256-byte block of memory that remains
 	// intact across restarts and restores
 	enum {
@@ -998,11 +998,56 @@ void GfxFrameout::drawEraseList(const RectList &eraseList, const Plane &plane) {
 	}
 }
 
+/**
+ * Returns true if drawing the given draw list entry is guaranteed to overwrite
+ * every pixel of its rect.
+ */
+static bool drawItemIsOpaque(const DrawItem &drawItem) {
+	const ScreenItem &screenItem = *drawItem.screenItem;
+	const CelObj &celObj = *screenItem._celObj;
+
+	if (celObj._info.type == kCelTypeColor) {
+		return true;
+	}
+
+	// Only the renderers which never test for the skip color are considered;
+	// compressed and scaled cels may still contain skip color pixels even when
+	// they are not flagged as transparent
+	return !celObj._remap &&
+		!celObj._transparent &&
+		celObj._compressionType == kCelCompressionNone &&
+		!screenItem._drawBlackLines &&
+		screenItem._ratioX.isOne() && screenItem._ratioY.isOne();
+}
+
 void GfxFrameout::drawScreenItemList(const DrawList &screenItemList) {
 	const DrawList::size_type drawListSize = screenItemList.size();
+
+	// The draw list is sorted by priority, so any entry which is entirely
+	// inside the rect of a later opaque entry would just be painted over
+	Common::Array<DrawList::size_type> opaqueIndexes;
+	for (DrawList::size_type i = 0; i < drawListSize; ++i) {
+		if (drawItemIsOpaque(*screenItemList[i])) {
+			opaqueIndexes.push_back(i);
+		}
+	}
+
 	for (DrawList::size_type i = 0; i < drawListSize; ++i) {
 		const DrawItem &drawItem = *screenItemList[i];
 		mergeToShowList(drawItem.rect, _showList, _overdrawThreshold);
+
+		bool isOccluded = false;
+		for (int j = (int)opaqueIndexes.size() - 1; j >= 0 && opaqueIndexes[j] > i; --j) {
+			if (screenItemList[opaqueIndexes[j]]->rect.contains(drawItem.rect)) {
+				isOccluded = true;
+				break;
+			}
+		}
+
+		if (isOccluded) {
+			continue;
+		}
+
 		const ScreenItem &screenItem = *drawItem.screenItem;
 		CelObj &celObj = *screenItem._celObj;
 		celObj.draw(_currentBuffer, screenItem, drawItem.rect, screenItem._mirrorX ^ celObj._mirrorX);
@@ -364,7 +364,8 @@ private:
 
 	/**
 	 * Draws all screen items from the given draw list to the visible screen
-	 * buffer.
+	 * buffer. Entries which are entirely covered by a higher-priority opaque
+	 * entry are not drawn.
 	 */
 	void drawScreenItemList(const DrawList &screenItemList);
 
@@ -41,6 +41,127 @@ void DrawList::add(ScreenItem *screenItem, const Common::Rect &rect) {
 	DrawListBase::add(drawItem);
 }
 
+#pragma mark -
+#pragma mark ScreenItemGrid
+void ScreenItemGrid::build(const ScreenItemList &screenItemList, const ScreenItemList::size_type count, const Common::Rect &bounds) {
+	_bounds = bounds;
+	_count = count;
+	_numColumns = MAX<int16>(1, MIN<int16>(kMaxCellsPerAxis, bounds.width()));
+	_numRows = MAX<int16>(1, MIN<int16>(kMaxCellsPerAxis, bounds.height()));
+	_cellWidth = MAX<int16>(1, (bounds.width() + _numColumns - 1) / _numColumns);
+	_cellHeight = MAX<int16>(1, (bounds.height() + _numRows - 1) / _numRows);
+
+	const uint numCells = _numColumns * _numRows;
+	_cellStarts.clear();
+	_cellStarts.resize(numCells + 1);
+	_cellItems.clear();
+	_unbinned.clear();
+	_queryStamps.clear();
+	_queryStamps.resize(count);
+	_queryStamp = 0;
+
+	// Rects which are empty, inverted, or not fully inside the grid bounds
+	// can still pass Common::Rect::intersects against some rects, so they are
+	// never binned
+	const bool gridIsEmpty = bounds.isEmpty();
+
+	// First pass counts the items in each cell, second pass fills the cells
+	for (int pass = 0; pass < 2; ++pass) {
+		for (ScreenItemList::size_type i = 0; i < count; ++i) {
+			const ScreenItem *item = screenItemList[i];
+			if (item == nullptr) {
+				continue;
+			}
+
+			const Common::Rect &rect = item->_screenRect;
+			if (gridIsEmpty || rect.isEmpty() || !bounds.contains(rect)) {
+				if (pass == 0) {
+					_unbinned.push_back(i);
+				}
+				continue;
+			}
+
+			const int16 firstColumn = getColumn(rect.left);
+			const int16 lastColumn = getColumn(rect.right - 1);
+			const int16 firstRow = getRow(rect.top);
+			const int16 lastRow = getRow(rect.bottom - 1);
+			for (int16 row = firstRow; row <= lastRow; ++row) {
+				for (int16 column = firstColumn; column <= lastColumn; ++column) {
+					const uint cell = row * _numColumns + column;
+					if (pass == 0) {
+						++_cellStarts[cell + 1];
+					} else {
+						_cellItems[_cellStarts[cell]++] = i;
+					}
+				}
+			}
+		}
+
+		if (pass == 0) {
+			for (uint cell = 0; cell < numCells; ++cell) {
+				_cellStarts[cell + 1] += _cellStarts[cell];
+			}
+			_cellItems.resize(_cellStarts[numCells]);
+		} else {
+			// Filling advanced each start offset to the start of the next
+			// cell, so shift them back into place
+			for (uint cell = numCells; cell > 0; --cell) {
+				_cellStarts[cell] = _cellStarts[cell - 1];
+			}
+			_cellStarts[0] = 0;
+		}
+	}
+}
+
+void ScreenItemGrid::findIntersecting(const Common::Rect &rect, IndexList &indexes) {
+	indexes.clear();
+
+	if (!rect.isValidRect()) {
+		for (ScreenItemList::size_type i = 0; i < _count; ++i) {
+			indexes.push_back(i);
+		}
+		return;
+	}
+
+	if (++_queryStamp == 0) {
+		Common::fill(_queryStamps.begin(), _queryStamps.end(), 0);
+		_queryStamp = 1;
+	}
+
+	for (IndexList::size_type i = 0; i < _unbinned.size(); ++i) {
+		_queryStamps[_unbinned[i]] = _queryStamp;
+		indexes.push_back(_unbinned[i]);
+	}
+
+	// An empty query rect can still intersect items which cover the pixel at
+	// its top-left corner
+	const int16 left = MAX(rect.left, _bounds.left);
+	const int16 top = MAX(rect.top, _bounds.top);
+	const int16 right = MIN<int16>(MAX<int16>(rect.left, rect.right - 1), _bounds.right - 1);
+	const int16 bottom = MIN<int16>(MAX<int16>(rect.top, rect.bottom - 1), _bounds.bottom - 1);
+
+	if (!_bounds.isEmpty() && left <= right && top <= bottom) {
+		const int16 lastColumn = getColumn(right);
+		const int16 lastRow = getRow(bottom);
+		for (int16 row = getRow(top); row <= lastRow; ++row) {
+			for (int16 column = getColumn(left); column <= lastColumn; ++column) {
+				const uint cell = row * _numColumns + column;
+				for (uint i = _cellStarts[cell]; i < _cellStarts[cell + 1]; ++i) {
+					const ScreenItemList::size_type index = _cellItems[i];
+					if (_queryStamps[index] != _queryStamp) {
+						_queryStamps[index] = _queryStamp;
+						indexes.push_back(index);
+					}
+				}
+			}
+		}
+	}
+
+	// Callers rely on visiting screen items in list order so that draw list
+	// entries are generated in the same order as a full scan
+	Common::sort(indexes.begin(), indexes.end());
+}
+
 #pragma mark -
 #pragma mark Plane
 uint16 Plane::_nextObjectId; // Will be initialized in Plane::init()
@@ -430,6 +551,12 @@ void Plane::calcLists(Plane &visiblePlane, const PlaneList &planeList, DrawList
 	DrawList::size_type drawListSizePrimary = drawList.size();
 	const RectList::size_type eraseListCount = eraseList.size();
 
+	// Screen item rects do not change for the rest of this function, so they
+	// can be indexed once to avoid testing every item against every rect
+	ScreenItemGrid grid;
+	grid.build(_screenItemList, MIN(screenItemCount, _screenItemList.size()), _screenRect);
+	ScreenItemGrid::IndexList candidates;
+
 	if (getSciVersion() == SCI_VERSION_3) {
 		_screenItemList.sort();
 		bool pictureDrawn = false;
@@ -477,7 +604,9 @@ void Plane::calcLists(Plane &visiblePlane, const PlaneList &planeList, DrawList
 		// Add all items overlapping the erase list to the draw list
 		for (RectList::size_type i = 0; i < eraseListCount; ++i) {
 			const Common::Rect &rect = *eraseList[i];
-			for (ScreenItemList::size_type j = 0; j < screenItemCount; ++j) {
+			grid.findIntersecting(rect, candidates);
+			for (ScreenItemGrid::IndexList::size_type k = 0; k < candidates.size(); ++k) {
+				const ScreenItemList::size_type j = candidates[k];
 				ScreenItem *item = _screenItemList[j];
 				if (
 					item != nullptr &&
@@ -503,7 +632,13 @@ void Plane::calcLists(Plane &visiblePlane, const PlaneList &planeList, DrawList
 				drawListEntry = drawList[i];
 			}
 
-			for (ScreenItemList::size_type j = 0; j < screenItemCount; ++j) {
+			if (drawListEntry == nullptr) {
+				continue;
+			}
+
+			grid.findIntersecting(drawListEntry->rect, candidates);
+			for (ScreenItemGrid::IndexList::size_type k = 0; k < candidates.size(); ++k) {
+				const ScreenItemList::size_type j = candidates[k];
 				ScreenItem *newItem = nullptr;
 				if (j < _screenItemList.size()) {
 					newItem = _screenItemList[j];
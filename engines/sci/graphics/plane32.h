@@ -92,6 +92,83 @@ public:
 	}
 };
 
+#pragma mark -
+#pragma mark ScreenItemGrid
+
+/**
+ * A coarse uniform grid over the screen rects of the screen items in a plane.
+ * It is used to quickly find the screen items which may intersect a dirty
+ * rect, instead of testing every screen item in the plane against every
+ * rect in the erase and draw lists.
+ */
+class ScreenItemGrid {
+public:
+	typedef Common::Array<ScreenItemList::size_type> IndexList;
+
+	/**
+	 * Indexes the first `count` entries of `screenItemList`. Items whose
+	 * screen rects do not lie entirely within `bounds` are always returned as
+	 * candidates by `findIntersecting`.
+	 */
+	void build(const ScreenItemList &screenItemList, const ScreenItemList::size_type count, const Common::Rect &bounds);
+
+	/**
+	 * Fills `indexes` with the indexes of all screen items whose screen rects
+	 * may intersect `rect`, in ascending order and without duplicates. Callers
+	 * must still perform their own intersection test.
+	 */
+	void findIntersecting(const Common::Rect &rect, IndexList &indexes);
+
+private:
+	enum {
+		/**
+		 * The maximum number of grid cells along each axis.
+		 */
+		kMaxCellsPerAxis = 16
+	};
+
+	Common::Rect _bounds;
+	int16 _cellWidth, _cellHeight;
+	int16 _numColumns, _numRows;
+
+	/**
+	 * The number of indexed screen items.
+	 */
+	ScreenItemList::size_type _count;
+
+	/**
+	 * The offset into `_cellItems` of the first screen item index for each
+	 * cell, plus a final entry holding the total number of entries.
+	 */
+	Common::Array<uint> _cellStarts;
+
+	/**
+	 * Screen item indexes for all cells, stored contiguously by cell.
+	 */
+	IndexList _cellItems;
+
+	/**
+	 * Screen items that are not stored in any cell and so are returned from
+	 * every query.
+	 */
+	IndexList _unbinned;
+
+	/**
+	 * Per-item marker used to avoid returning the same screen item more than
+	 * once from a single query.
+	 */
+	Common::Array<uint> _queryStamps;
+	uint _queryStamp;
+
+	inline int16 getColumn(const int16 x) const {
+		return (x - _bounds.left) / _cellWidth;
+	}
+
+	inline int16 getRow(const int16 y) const {
+		return (y - _bounds.top) / _cellHeight;
+	}
+};
+
 class PlaneList;
 
 #pragma mark -
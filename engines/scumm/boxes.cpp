@@ -190,6 +190,9 @@ byte ScummEngine::getMaskFromBox(int box) {
 void ScummEngine::setBoxFlags(int box, int val) {
 	debug(2, "setBoxFlags(%d, 0x%02x)", box, val);
 
+	// In v0 games the flags of one box overlap the coordinates of the next
+	invalidateBoxCache();
+
 	/* SCUMM7+ stuff */
 	if (val & 0xC000) {
 		assert(box >= 0 && box < 65);
@@ -222,6 +225,8 @@ byte ScummEngine::getBoxFlags(int box) {
 }
 
 void ScummEngine::setBoxScale(int box, int scale) {
+	invalidateBoxCache();
+
 	Box *ptr = getBoxBaseAddr(box);
 	assert(ptr);
 	if (_game.version == 8)
@@ -233,6 +238,8 @@ void ScummEngine::setBoxScale(int box, int scale) {
 }
 
 void ScummEngine::setBoxScaleSlot(int box, int slot) {
+	invalidateBoxCache();
+
 	Box *ptr = getBoxBaseAddr(box);
 	assert(ptr);
 	ptr->v8.scaleSlot = TO_LE_32(slot);
@@ -519,24 +526,35 @@ bool ScummEngine::checkXYInBoxBounds(int boxnum, int x, int y) {
 	if (boxnum < 0 || boxnum == Actor::kInvalidBox)
 		return false;
 
-	BoxCoords box = getBoxCoordinates(boxnum);
-	const Common::Point p(x, y);
+	if (!_boxCache.valid)
+		updateBoxCache();
 
 	// Quick check: If the x (resp. y) coordinate of the point is
 	// strictly smaller (bigger) than the x (y) coordinates of all
 	// corners of the quadrangle, then it certainly is *not* contained
 	// inside the quadrangle.
-	if (x < box.ul.x && x < box.ur.x && x < box.lr.x && x < box.ll.x)
-		return false;
+	if (boxnum < _boxCache.numBoxes) {
+		if (x < _boxCache.minX[boxnum] || x > _boxCache.maxX[boxnum] ||
+			y < _boxCache.minY[boxnum] || y > _boxCache.maxY[boxnum])
+			return false;
+	}
 
-	if (x > box.ul.x && x > box.ur.x && x > box.lr.x && x > box.ll.x)
-		return false;
+	BoxCoords box = getBoxCoordinates(boxnum);
+	const Common::Point p(x, y);
 
-	if (y < box.ul.y && y < box.ur.y && y < box.lr.y && y < box.ll.y)
-		return false;
+	if (boxnum >= _boxCache.numBoxes) {
+		if (x < box.ul.x && x < box.ur.x && x < box.lr.x && x < box.ll.x)
+			return false;
 
-	if (y > box.ul.y && y > box.ur.y && y > box.lr.y && y > box.ll.y)
-		return false;
+		if (x > box.ul.x && x > box.ur.x && x > box.lr.x && x > box.ll.x)
+			return false;
+
+		if (y < box.ul.y && y < box.ur.y && y < box.lr.y && y < box.ll.y)
+			return false;
+
+		if (y > box.ul.y && y > box.ur.y && y > box.lr.y && y > box.ll.y)
+			return false;
+	}
 
 	// Corner case: If the box is a simple line segment, we consider the
 	// point to be contained "in" (or rather, lying on) the line if it
@@ -570,7 +588,75 @@ bool ScummEngine::checkXYInBoxBounds(int boxnum, int x, int y) {
 	return true;
 }
 
+void ScummEngine::invalidateBoxCache() {
+	_boxCache.valid = false;
+}
+
+void ScummEngine::updateBoxCache() {
+	const int num = getNumBoxes();
+
+	_boxCache.valid = true;
+	_boxCache.numBoxes = num;
+
+	_boxCache.ulX.resize(num);
+	_boxCache.ulY.resize(num);
+	_boxCache.urX.resize(num);
+	_boxCache.urY.resize(num);
+	_boxCache.lrX.resize(num);
+	_boxCache.lrY.resize(num);
+	_boxCache.llX.resize(num);
+	_boxCache.llY.resize(num);
+	_boxCache.minX.resize(num);
+	_boxCache.minY.resize(num);
+	_boxCache.maxX.resize(num);
+	_boxCache.maxY.resize(num);
+
+	for (int i = 0; i < num; i++) {
+		const BoxCoords box = decodeBoxCoordinates(i);
+
+		_boxCache.ulX[i] = box.ul.x;
+		_boxCache.ulY[i] = box.ul.y;
+		_boxCache.urX[i] = box.ur.x;
+		_boxCache.urY[i] = box.ur.y;
+		_boxCache.lrX[i] = box.lr.x;
+		_boxCache.lrY[i] = box.lr.y;
+		_boxCache.llX[i] = box.ll.x;
+		_boxCache.llY[i] = box.ll.y;
+
+		_boxCache.minX[i] = MIN(MIN(box.ul.x, box.ur.x), MIN(box.lr.x, box.ll.x));
+		_boxCache.minY[i] = MIN(MIN(box.ul.y, box.ur.y), MIN(box.lr.y, box.ll.y));
+		_boxCache.maxX[i] = MAX(MAX(box.ul.x, box.ur.x), MAX(box.lr.x, box.ll.x));
+		_boxCache.maxY[i] = MAX(MAX(box.ul.y, box.ur.y), MAX(box.lr.y, box.ll.y));
+	}
+
+	// Itinerary rows are expanded from the box matrix on demand
+	_boxCache.itineraryRowValid.clear();
+	_boxCache.itineraryRowValid.resize(num);
+	_boxCache.itinerary.resize(num * num);
+}
+
 BoxCoords ScummEngine::getBoxCoordinates(int boxnum) {
+	if (!_boxCache.valid)
+		updateBoxCache();
+
+	// Out of range requests are left to the resource accessors, which
+	// implement the workarounds for broken scripts
+	if (boxnum < 0 || boxnum >= _boxCache.numBoxes)
+		return decodeBoxCoordinates(boxnum);
+
+	BoxCoords box;
+	box.ul.x = _boxCache.ulX[boxnum];
+	box.ul.y = _boxCache.ulY[boxnum];
+	box.ur.x = _boxCache.urX[boxnum];
+	box.ur.y = _boxCache.urY[boxnum];
+	box.lr.x = _boxCache.lrX[boxnum];
+	box.lr.y = _boxCache.lrY[boxnum];
+	box.ll.x = _boxCache.llX[boxnum];
+	box.ll.y = _boxCache.llY[boxnum];
+	return box;
+}
+
+BoxCoords ScummEngine::decodeBoxCoordinates(int boxnum) {
 	BoxCoords tmp, *box = &tmp;
 	Box *bp = getBoxBaseAddr(boxnum);
 	assert(bp);
@@ -753,6 +839,19 @@ int ScummEngine::getNextBox(byte from, byte to) {
 		return (int8)boxm[to];
 	}
 
+	// WORKAROUND #2: In addition to the above, we have to add this special
+	// case to fix the scene in Indy3 where Indy meets Hitler in Berlin.
+	// See bug #1017 and also bug #1052.
+	if ((_game.id == GID_INDY3) && _roomResource == 46 && from == 1 && to == 0)
+		return 0;
+
+	if (!_boxCache.valid)
+		updateBoxCache();
+
+	int8 *itinerary = &_boxCache.itinerary[from * numOfBoxes];
+	if (_boxCache.itineraryRowValid[from])
+		return itinerary[to];
+
 	// WORKAROUND #1: It seems that in some cases, the box matrix is corrupt
 	// (more precisely, is too short) in the datafiles already. In
 	// particular this seems to be the case in room 46 of Indy3 EGA (see
@@ -766,12 +865,6 @@ int ScummEngine::getNextBox(byte from, byte to) {
 	// resource, and abort the search once we reach the end.
 	const byte *end = boxm + getResourceSize(rtMatrix, 1);
 
-	// WORKAROUND #2: In addition to the above, we have to add this special
-	// case to fix the scene in Indy3 where Indy meets Hitler in Berlin.
-	// See bug #1017 and also bug #1052.
-	if ((_game.id == GID_INDY3) && _roomResource == 46 && from == 1 && to == 0)
-		return 0;
-
 	// Skip up to the matrix data for box 'from'
 	for (i = 0; i < from && boxm < end; i++) {
 		while (boxm < end && *boxm != 0xFF)
@@ -779,16 +872,23 @@ int ScummEngine::getNextBox(byte from, byte to) {
 		boxm++;
 	}
 
-	// Now search for the entry for box 'to'
+	// Now expand the whole row for box 'from'. Later entries take
+	// precedence over earlier ones.
+	for (int j = 0; j < numOfBoxes; j++)
+		itinerary[j] = -1;
+
 	while (boxm < end && boxm[0] != 0xFF) {
-		if (boxm[0] <= to && to <= boxm[1])
-			dest = (int8)boxm[2];
+		for (int j = boxm[0]; j <= boxm[1] && j < numOfBoxes; j++)
+			itinerary[j] = (int8)boxm[2];
 		boxm += 3;
 	}
 
 	if (boxm >= end)
 		debug(0, "The box matrix apparently is truncated (room %d)", _roomResource);
 
+	_boxCache.itineraryRowValid[from] = true;
+	dest = itinerary[to];
+
 	return dest;
 }
 
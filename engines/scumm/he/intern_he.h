@@ -216,6 +216,8 @@ public:
 
 	Wiz *_wiz;
 
+	void invalidateImageResource(ResId idx) override;
+
 	virtual int setupStringArray(int size);
 
 protected:
@@ -64,6 +64,8 @@ void Moonbase::initFOW() {
 
 void Moonbase::releaseFOWResources() {
 	if (_fowImage) {
+		// Decoded FOW tiles are cached by the address of their data
+		_vm->_wiz->flushDecodedWizImages();
 		free(_fowImage);
 		_fowImage = 0;
 	}
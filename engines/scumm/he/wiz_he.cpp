@@ -40,6 +40,12 @@ Wiz::Wiz(ScummEngine_v71he *vm) : _vm(vm) {
 	memset(&_polygons, 0, sizeof(_polygons));
 	_cursorImage = false;
 	_rectOverrideEnabled = false;
+	_decodedImageBytes = 0;
+	_decodedImageTick = 0;
+}
+
+Wiz::~Wiz() {
+	flushDecodedWizImages();
 }
 
 void Wiz::clearWizBuffer() {
@@ -413,6 +419,215 @@ void Wiz::copyWizImage(uint8 *dst, const uint8 *src, int dstPitch, int dstType,
 	}
 }
 
+void Wiz::copyDecodedWizImage(uint8 *dst, const WizDecodedImage &img, int dstPitch, int dstType, int dstw, int dsth, int srcx, int srcy, const Common::Rect *rect, int flags, const uint8 *palPtr, const uint8 *xmapPtr, uint8 bitDepth) {
+	Common::Rect r1, r2;
+	if (calcClipRects(dstw, dsth, srcx, srcy, img.width, img.height, rect, r1, r2)) {
+		dst += r2.top * dstPitch + r2.left * bitDepth;
+		if (flags & kWIFFlipY) {
+			const int dy = (srcy < 0) ? srcy : (img.height - r1.height());
+			r1.translate(0, dy);
+		}
+		if (flags & kWIFFlipX) {
+			const int dx = (srcx < 0) ? srcx : (img.width - r1.width());
+			r1.translate(dx, 0);
+		}
+		if (xmapPtr) {
+			drawDecodedWizImage<kWizXMap>(dst, dstPitch, dstType, img, r1, flags, palPtr, xmapPtr, bitDepth);
+		} else if (palPtr && img.bytesPerPixel == 1) {
+			drawDecodedWizImage<kWizRMap>(dst, dstPitch, dstType, img, r1, flags, palPtr, NULL, bitDepth);
+		} else {
+			drawDecodedWizImage<kWizCopy>(dst, dstPitch, dstType, img, r1, flags, NULL, NULL, bitDepth);
+		}
+	}
+}
+
+template<int type>
+void Wiz::drawDecodedWizImage(uint8 *dst, int dstPitch, int dstType, const WizDecodedImage &img, const Common::Rect &srcRect, int flags, const uint8 *palPtr, const uint8 *xmapPtr, uint8 bitDepth) {
+	int h = srcRect.height();
+	int w = srcRect.width();
+	if (h <= 0 || w <= 0)
+		return;
+
+	// Same destination walk as decompressWizImage(), but the pixels come
+	// straight from the decoded rows and only the opaque spans are visited.
+	uint8 *dstRow = dst;
+	if (flags & kWIFFlipY) {
+		dstRow += (h - 1) * dstPitch;
+		dstPitch = -dstPitch;
+	}
+	int dstInc = bitDepth;
+	if (flags & kWIFFlipX) {
+		dstRow += (w - 1) * bitDepth;
+		dstInc = -bitDepth;
+	}
+
+	const int srcBpp = img.bytesPerPixel;
+	for (int y = srcRect.top; y < srcRect.bottom; ++y, dstRow += dstPitch) {
+		// Flipped images clipped by a clip box can ask for rows outside of
+		// the image, which the RLE decoder would read as garbage.
+		if (y < 0 || y >= img.height)
+			continue;
+
+		const uint16 *span = img.spans.begin() + img.rowSpans[y] * 2;
+		const uint16 *spanEnd = img.spans.begin() + img.rowSpans[y + 1] * 2;
+		for (; span != spanEnd; span += 2) {
+			if (span[0] >= srcRect.right)
+				break;
+
+			const int x0 = MAX<int>(span[0], srcRect.left);
+			const int x1 = MIN<int>(span[0] + span[1], srcRect.right);
+			if (x0 >= x1)
+				continue;
+
+			const uint8 *dataPtr = img.pixels + (y * img.width + x0) * srcBpp;
+			uint8 *dstPtr = dstRow + (x0 - srcRect.left) * dstInc;
+			int count = x1 - x0;
+
+			if (type == kWizCopy && srcBpp == 1 && dstInc == 1) {
+				memcpy(dstPtr, dataPtr, count);
+				continue;
+			}
+
+			while (count--) {
+#ifdef USE_RGB_COLOR
+				if (srcBpp == 2)
+					write16BitColor<type == kWizXMap ? kWizXMap : kWizCopy>(dstPtr, dataPtr, dstType, xmapPtr);
+				else
+#endif
+					write8BitColor<type>(dstPtr, dataPtr, dstType, palPtr, xmapPtr, bitDepth);
+				dataPtr += srcBpp;
+				dstPtr += dstInc;
+			}
+		}
+	}
+}
+
+WizDecodedImage *Wiz::decodeWizImage(const uint8 *wizd, int width, int height, uint8 bytesPerPixel) {
+	WizDecodedImage *img = new WizDecodedImage();
+	img->width = width;
+	img->height = height;
+	img->bytesPerPixel = bytesPerPixel;
+	img->pixels = (uint8 *)calloc(width * height, bytesPerPixel);
+	if (!img->pixels) {
+		delete img;
+		return nullptr;
+	}
+	img->rowSpans.resize(height + 1);
+
+	const uint8 *dataPtr = wizd;
+	for (int y = 0; y < height; y++) {
+		img->rowSpans[y] = img->spans.size() / 2;
+
+		uint16 lineSize = READ_LE_UINT16(dataPtr); dataPtr += 2;
+		const uint8 *dataPtrNext = dataPtr + lineSize;
+		uint8 *rowPtr = img->pixels + y * width * bytesPerPixel;
+		int x = 0;
+		while (lineSize != 0 && x < width && dataPtr < dataPtrNext) {
+			uint8 code = *dataPtr++;
+			if (code & 1) {
+				x += code >> 1;
+				continue;
+			}
+
+			int count = MIN<int>((code >> 2) + 1, width - x);
+			if (code & 2) {
+				for (int i = 0; i < count; i++)
+					memcpy(rowPtr + (x + i) * bytesPerPixel, dataPtr, bytesPerPixel);
+				dataPtr += bytesPerPixel;
+			} else {
+				memcpy(rowPtr + x * bytesPerPixel, dataPtr, count * bytesPerPixel);
+				dataPtr += ((code >> 2) + 1) * bytesPerPixel;
+			}
+
+			// Runs and literals often follow each other directly, so merge
+			// them into a single opaque span
+			uint numSpans = img->spans.size();
+			if (numSpans > img->rowSpans[y] * 2 && img->spans[numSpans - 2] + img->spans[numSpans - 1] == x) {
+				img->spans[numSpans - 1] += count;
+			} else {
+				img->spans.push_back(x);
+				img->spans.push_back(count);
+			}
+			x += count;
+		}
+		dataPtr = dataPtrNext;
+	}
+	img->rowSpans[height] = img->spans.size() / 2;
+
+	img->size = sizeof(WizDecodedImage) + width * height * bytesPerPixel +
+		img->rowSpans.size() * sizeof(uint32) + img->spans.size() * sizeof(uint16);
+	return img;
+}
+
+const WizDecodedImage *Wiz::getDecodedWizImage(const uint8 *wizd, int width, int height, uint8 bytesPerPixel) {
+	DecodedImageMap::iterator it = _decodedImages.find(wizd);
+	if (it != _decodedImages.end()) {
+		WizDecodedImage *img = it->_value;
+		if (img->width == width && img->height == height && img->bytesPerPixel == bytesPerPixel) {
+			img->lastUsed = ++_decodedImageTick;
+			return img;
+		}
+		_decodedImageBytes -= img->size;
+		delete img;
+		_decodedImages.erase(it);
+	}
+
+	// Images which would take a large part of the budget by themselves are
+	// usually backgrounds drawn once; decode those directly.
+	if (width <= 0 || height <= 0 || (uint32)(width * height * bytesPerPixel) > kDecodedImageBudget / 4)
+		return nullptr;
+
+	WizDecodedImage *img = decodeWizImage(wizd, width, height, bytesPerPixel);
+	if (!img)
+		return nullptr;
+
+	img->lastUsed = ++_decodedImageTick;
+	_decodedImages[wizd] = img;
+	_decodedImageBytes += img->size;
+	if (_decodedImageBytes > kDecodedImageBudget)
+		evictDecodedWizImages(wizd);
+
+	return img;
+}
+
+void Wiz::evictDecodedWizImages(const uint8 *keep) {
+	while (_decodedImageBytes > kDecodedImageBudget) {
+		DecodedImageMap::iterator oldest = _decodedImages.end();
+		for (DecodedImageMap::iterator it = _decodedImages.begin(); it != _decodedImages.end(); ++it) {
+			if (it->_key != keep && (oldest == _decodedImages.end() || it->_value->lastUsed < oldest->_value->lastUsed))
+				oldest = it;
+		}
+		if (oldest == _decodedImages.end())
+			break;
+
+		_decodedImageBytes -= oldest->_value->size;
+		delete oldest->_value;
+		_decodedImages.erase(oldest);
+	}
+}
+
+void Wiz::invalidateDecodedWizImages(const uint8 *ptr, uint32 size) {
+	Common::Array<const uint8 *> stale;
+	for (DecodedImageMap::iterator it = _decodedImages.begin(); it != _decodedImages.end(); ++it) {
+		if (it->_key >= ptr && it->_key < ptr + size)
+			stale.push_back(it->_key);
+	}
+
+	for (uint i = 0; i < stale.size(); i++) {
+		DecodedImageMap::iterator it = _decodedImages.find(stale[i]);
+		_decodedImageBytes -= it->_value->size;
+		delete it->_value;
+		_decodedImages.erase(it);
+	}
+}
+
+void Wiz::flushDecodedWizImages() {
+	for (DecodedImageMap::iterator it = _decodedImages.begin(); it != _decodedImages.end(); ++it)
+		delete it->_value;
+	_decodedImages.clear();
+	_decodedImageBytes = 0;
+}
+
 static void decodeWizMask(uint8 *&dst, uint8 &mask, int w, int maskType) {
 	switch (maskType) {
 	case 0:
@@ -1628,7 +1843,13 @@ void Wiz::drawWizImageEx(uint8 *dst, uint8 *dataPtr, uint8 *maskPtr, int dstPitc
 			dstPitch /= _vm->_bytesPerPixel;
 			copyWizImageWithMask(dst, wizd, dstPitch, dstw, dsth, srcx, srcy, srcw, srch, rect, 0, 1);
 		} else {
-			copyWizImage(dst, wizd, dstPitch, dstType, dstw, dsth, srcx, srcy, srcw, srch, rect, flags, palPtr, xmapPtr, bitDepth);
+			const WizDecodedImage *img = NULL;
+			if ((uint32)srcw == width && (uint32)srch == height)
+				img = getDecodedWizImage(wizd, width, height, 1);
+			if (img)
+				copyDecodedWizImage(dst, *img, dstPitch, dstType, dstw, dsth, srcx, srcy, rect, flags, palPtr, xmapPtr, bitDepth);
+			else
+				copyWizImage(dst, wizd, dstPitch, dstType, dstw, dsth, srcx, srcy, srcw, srch, rect, flags, palPtr, xmapPtr, bitDepth);
 		}
 		break;
 #ifdef USE_RGB_COLOR
@@ -1642,9 +1863,16 @@ void Wiz::drawWizImageEx(uint8 *dst, uint8 *dataPtr, uint8 *maskPtr, int dstPitc
 	case 4:
 		copyCompositeWizImage(dst, dataPtr, wizd, maskPtr, dstPitch, dstType, dstw, dsth, srcx, srcy, srcw, srch, state, rect, flags, palPtr, transColor, bitDepth, xmapPtr, conditionBits);
 		break;
-	case 5:
-		copy16BitWizImage(dst, wizd, dstPitch, dstType, dstw, dsth, srcx, srcy, srcw, srch, rect, flags, xmapPtr);
+	case 5: {
+		const WizDecodedImage *img = NULL;
+		if ((uint32)srcw == width && (uint32)srch == height)
+			img = getDecodedWizImage(wizd, width, height, 2);
+		if (img)
+			copyDecodedWizImage(dst, *img, dstPitch, dstType, dstw, dsth, srcx, srcy, rect, flags, NULL, xmapPtr, 2);
+		else
+			copy16BitWizImage(dst, wizd, dstPitch, dstType, dstw, dsth, srcx, srcy, srcw, srch, rect, flags, xmapPtr);
 		break;
+	}
 	case 9:
 		copy555WizImage(dst, wizd, dstPitch, dstType, dstw, dsth, srcx, srcy, rect, conditionBits);
 		break;
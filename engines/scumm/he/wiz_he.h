@@ -22,6 +22,9 @@
 #if !defined(SCUMM_HE_WIZ_HE_H) && defined(ENABLE_HE)
 #define SCUMM_HE_WIZ_HE_H
 
+#include "common/array.h"
+#include "common/hashmap.h"
+#include "common/hash-ptr.h"
 #include "common/rect.h"
 
 namespace Scumm {
@@ -230,6 +233,31 @@ enum DstSurface {
  	kDstCursor   = 3
 };
 
+/**
+ * A fully decoded state of an RLE compressed Wiz image (compression type 1
+ * or 5), kept so that redrawing an unchanged sprite does not have to walk
+ * the RLE stream again.
+ *
+ * Pixels are stored exactly as they appear in the RLE data (palette indices
+ * or little endian 16-bit colors), so palette remapping and XMAP shadows
+ * are still applied at blit time and one entry serves every variant.
+ * Transparency is kept as a list of opaque spans per row.
+ */
+struct WizDecodedImage {
+	int width;
+	int height;
+	uint8 bytesPerPixel;
+	uint32 size;
+	uint32 lastUsed;
+
+	uint8 *pixels;
+	Common::Array<uint32> rowSpans; ///< Index of each row's first span, plus one end marker
+	Common::Array<uint16> spans;    ///< (x, length) pairs of opaque pixels, sorted by x
+
+	WizDecodedImage() : width(0), height(0), bytesPerPixel(0), size(0), lastUsed(0), pixels(nullptr) {}
+	~WizDecodedImage() { free(pixels); }
+};
+
 class ScummEngine_v71he;
 
 class Wiz {
@@ -244,6 +272,7 @@ public:
 	WizPolygon _polygons[NUM_POLYGONS];
 
 	Wiz(ScummEngine_v71he *vm);
+	~Wiz();
 
 	void clearWizBuffer();
 	Common::Rect _rectOverride;
@@ -280,6 +309,9 @@ public:
 
 	void flushWizBuffer();
 
+	void invalidateDecodedWizImages(const uint8 *ptr, uint32 size);
+	void flushDecodedWizImages();
+
 	void getWizImageSpot(int resId, int state, int32 &x, int32 &y);
 	void getWizImageSpot(uint8 *data, int state, int32 &x, int32 &y);
 	void loadWizCursor(int resId, int palette);
@@ -333,6 +365,21 @@ public:
 
 private:
 	ScummEngine_v71he *_vm;
+
+	enum {
+		kDecodedImageBudget = 8 * 1024 * 1024
+	};
+
+	typedef Common::HashMap<const uint8 *, WizDecodedImage *> DecodedImageMap;
+	DecodedImageMap _decodedImages;
+	uint32 _decodedImageBytes;
+	uint32 _decodedImageTick;
+
+	const WizDecodedImage *getDecodedWizImage(const uint8 *wizd, int width, int height, uint8 bytesPerPixel);
+	WizDecodedImage *decodeWizImage(const uint8 *wizd, int width, int height, uint8 bytesPerPixel);
+	void evictDecodedWizImages(const uint8 *keep);
+	static void copyDecodedWizImage(uint8 *dst, const WizDecodedImage &img, int dstPitch, int dstType, int dstw, int dsth, int srcx, int srcy, const Common::Rect *rect, int flags, const uint8 *palPtr, const uint8 *xmapPtr, uint8 bitDepth);
+	template<int type> static void drawDecodedWizImage(uint8 *dst, int dstPitch, int dstType, const WizDecodedImage &img, const Common::Rect &srcRect, int flags, const uint8 *palPtr, const uint8 *xmapPtr, uint8 bitDepth);
 };
 
 } // End of namespace Scumm
@@ -909,6 +909,12 @@ bool ResourceManager::validateResource(const char *str, ResType type, ResId idx)
 }
 
 void ResourceManager::nukeResource(ResType type, ResId idx) {
+	// Drop data cached from resources about to be freed or replaced
+	if (type == rtMatrix)
+		_vm->invalidateBoxCache();
+	else if (type == rtImage)
+		_vm->invalidateImageResource(idx);
+
 	byte *ptr = _types[type][idx]._address;
 	if (ptr != nullptr) {
 		debugC(DEBUG_RESOURCE, "nukeResource(%s,%d)", nameOfResType(type), idx);
@@ -1007,6 +1013,8 @@ void ResourceManager::setModified(ResType type, ResId idx) {
 	if (!validateResource("Modified", type, idx))
 		return;
 	_types[type][idx].setModified();
+	if (type == rtImage)
+		_vm->invalidateImageResource(idx);
 }
 
 void ResourceManager::setOffHeap(ResType type, ResId idx) {
@@ -308,6 +308,8 @@ ScummEngine::ScummEngine(OSystem *syst, const DetectorResult &dr)
 	_defaultTalkDelay = 0;
 	_saveSound = 0;
 	memset(_extraBoxFlags, 0, sizeof(_extraBoxFlags));
+	_boxCache.valid = false;
+	_boxCache.numBoxes = 0;
 	memset(_scaleSlots, 0, sizeof(_scaleSlots));
 	_charset = nullptr;
 	_charsetColor = 0;
@@ -940,6 +942,12 @@ ScummEngine_v71he::~ScummEngine_v71he() {
 	delete _wiz;
 }
 
+void ScummEngine_v71he::invalidateImageResource(ResId idx) {
+	const ResourceManager::Resource &res = _res->_types[rtImage][idx];
+	if (res._address)
+		_wiz->invalidateDecodedWizImages(res._address, res._size);
+}
+
 ScummEngine_v72he::ScummEngine_v72he(OSystem *syst, const DetectorResult &dr)
 	: ScummEngine_v71he(syst, dr) {
 	VAR_NUM_ROOMS = 0xFF;
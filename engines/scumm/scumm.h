@@ -710,6 +710,9 @@ public:
 	int getResourceDataSize(const byte *ptr) const;
 	void dumpResource(const char *tag, int index, const byte *ptr, int length = -1);
 
+	/** Called before an image resource is freed or after it was modified in place. */
+	virtual void invalidateImageResource(ResId idx) {}
+
 public:
 	/* Should be in Object class */
 	byte OF_OWNER_ROOM;
@@ -1091,7 +1094,29 @@ public:
 	int getScale(int box, int x, int y);
 	int getScaleFromSlot(int slot, int x, int y);
 
+	void invalidateBoxCache();
+
 protected:
+	/**
+	 * Walk box data of the current room, decoded from the box resources when
+	 * first needed. Box corners and bounds are kept in separate arrays per
+	 * component, and rows of the itinerary matrix are expanded from the
+	 * compressed box matrix on first use, so that walk queries don't have to
+	 * decode the raw resources again. Invalidated whenever a box resource is
+	 * replaced or modified.
+	 */
+	struct BoxCache {
+		bool valid;
+		int numBoxes;
+		Common::Array<int16> ulX, ulY, urX, urY, lrX, lrY, llX, llY;
+		Common::Array<int16> minX, minY, maxX, maxY;
+		Common::Array<bool> itineraryRowValid;
+		Common::Array<int8> itinerary;
+	};
+	BoxCache _boxCache;
+	void updateBoxCache();
+	BoxCoords decodeBoxCoordinates(int boxnum);
+
 	// Scaling slots/items
 	struct ScaleSlot {
 		int x1, y1, scale1;
@@ -69,6 +69,33 @@ namespace Scumm {
 		(dst)[1] = val;	\
 	} while (0)
 
+// Fixed-size memcpy/memset are turned into single wide loads and stores by
+// the compiler, and are safe on platforms which need aligned accesses
+#define COPY_8X1_LINE(dst, src)			\
+	memcpy((dst), (src), 8)
+
+#define FILL_8X1_LINE(dst, val)			\
+	memset((dst), (val), 8)
+
+/**
+ * Writes one row of a two-color pattern block: bytes of dst where mask is
+ * 0xFF are set to val1, all others to val2. The row is processed as a single
+ * machine word.
+ */
+static inline void blendPatternLine8(byte *dst, const byte *mask, byte val1, byte val2) {
+	uint64 m, r;
+	memcpy(&m, mask, 8);
+	r = (m & (val1 * 0x0101010101010101ULL)) | (~m & (val2 * 0x0101010101010101ULL));
+	memcpy(dst, &r, 8);
+}
+
+static inline void blendPatternLine4(byte *dst, const byte *mask, byte val1, byte val2) {
+	uint32 m, r;
+	memcpy(&m, mask, 4);
+	r = (m & (val1 * 0x01010101U)) | (~m & (val2 * 0x01010101U));
+	memcpy(dst, &r, 4);
+}
+
 static const  int8 codec47_table_small1[] = {
   0, 1, 2, 3, 3, 3, 3, 2, 1, 0, 0, 0, 1, 2, 2, 1,
 };
@@ -152,6 +179,7 @@ void Codec47Decoder::makeTablesInterpolation(int param) {
 	if (param == 8) {
 		table47_1 = codec47_table_big1;
 		table47_2 = codec47_table_big2;
+		memset(_patternBig, 0, 256 * 64);
 		ptr = _tableBig;
 		for (i = 0; i < 256; i++) {
 			ptr[384] = 0;
@@ -161,6 +189,7 @@ void Codec47Decoder::makeTablesInterpolation(int param) {
 	} else if (param == 4) {
 		table47_1 = codec47_table_small1;
 		table47_2 = codec47_table_small2;
+		memset(_patternSmall, 0, 256 * 16);
 		ptr = _tableSmall;
 		for (i = 0; i < 256; i++) {
 			ptr[96] = 0;
@@ -266,6 +295,7 @@ void Codec47Decoder::makeTablesInterpolation(int param) {
 					if (tableSmallBig[i] != 0) {
 						_tableBig[256 + s + _tableBig[384 + s]] = (byte)i;
 						_tableBig[384 + s]++;
+						_patternBig[(s / 388) * 64 + i] = 0xFF;
 					} else {
 						_tableBig[320 + s + _tableBig[385 + s]] = (byte)i;
 						_tableBig[385 + s]++;
@@ -278,6 +308,7 @@ void Codec47Decoder::makeTablesInterpolation(int param) {
 					if (tableSmallBig[i] != 0) {
 						_tableSmall[64 + s + _tableSmall[96 + s]] = (byte)i;
 						_tableSmall[96 + s]++;
+						_patternSmall[(s / 128) * 16 + i] = 0xFF;
 					} else {
 						_tableSmall[80 + s + _tableSmall[97 + s]] = (byte)i;
 						_tableSmall[97 + s]++;
@@ -412,20 +443,15 @@ void Codec47Decoder::level2(byte *d_dst) {
 			d_dst += _d_pitch;
 		}
 	} else if (code == 0xFD) {
-		byte *tmp_ptr = _tableSmall + *_d_src++ * 128;
-		int32 l = tmp_ptr[96];
-		byte val = *_d_src++;
-		int16 *tmp_ptr2 = (int16 *)tmp_ptr;
-		while (l--) {
-			*(d_dst + READ_LE_UINT16(tmp_ptr2)) = val;
-			tmp_ptr2++;
-		}
-		l = tmp_ptr[97];
-		val = *_d_src++;
-		tmp_ptr2 = (int16 *)(tmp_ptr + 32);
-		while (l--) {
-			*(d_dst + READ_LE_UINT16(tmp_ptr2)) = val;
-			tmp_ptr2++;
+		// The two pixel lists of a pattern cover the whole block, so it
+		// can be written row by row from a precomputed mask
+		const byte *mask = _patternSmall + *_d_src++ * 16;
+		byte val1 = *_d_src++;
+		byte val2 = *_d_src++;
+		for (i = 0; i < 4; i++) {
+			blendPatternLine4(d_dst, mask, val1, val2);
+			mask += 4;
+			d_dst += _d_pitch;
 		}
 	} else if (code == 0xFC) {
 		tmp = _offset2;
@@ -443,15 +469,14 @@ void Codec47Decoder::level2(byte *d_dst) {
 }
 
 void Codec47Decoder::level1(byte *d_dst) {
-	int32 tmp, tmp2;
+	int32 tmp2;
 	byte code = *_d_src++;
 	int i;
 
 	if (code < 0xF8) {
 		tmp2 = _table[code] + _offset1;
 		for (i = 0; i < 8; i++) {
-			COPY_4X1_LINE(d_dst + 0, d_dst + tmp2);
-			COPY_4X1_LINE(d_dst + 4, d_dst + tmp2 + 4);
+			COPY_8X1_LINE(d_dst, d_dst + tmp2);
 			d_dst += _d_pitch;
 		}
 	} else if (code == 0xFF) {
@@ -465,39 +490,28 @@ void Codec47Decoder::level1(byte *d_dst) {
 	} else if (code == 0xFE) {
 		byte t = *_d_src++;
 		for (i = 0; i < 8; i++) {
-			FILL_4X1_LINE(d_dst, t);
-			FILL_4X1_LINE(d_dst + 4, t);
+			FILL_8X1_LINE(d_dst, t);
 			d_dst += _d_pitch;
 		}
 	} else if (code == 0xFD) {
-		tmp = *_d_src++;
-		byte *tmp_ptr = _tableBig + tmp * 388;
-		byte l = tmp_ptr[384];
-		byte val = *_d_src++;
-		int16 *tmp_ptr2 = (int16 *)tmp_ptr;
-		while (l--) {
-			*(d_dst + READ_LE_UINT16(tmp_ptr2)) = val;
-			tmp_ptr2++;
-		}
-		l = tmp_ptr[385];
-		val = *_d_src++;
-		tmp_ptr2 = (int16 *)(tmp_ptr + 128);
-		while (l--) {
-			*(d_dst + READ_LE_UINT16(tmp_ptr2)) = val;
-			tmp_ptr2++;
+		const byte *mask = _patternBig + *_d_src++ * 64;
+		byte val1 = *_d_src++;
+		byte val2 = *_d_src++;
+		for (i = 0; i < 8; i++) {
+			blendPatternLine8(d_dst, mask, val1, val2);
+			mask += 8;
+			d_dst += _d_pitch;
 		}
 	} else if (code == 0xFC) {
 		tmp2 = _offset2;
 		for (i = 0; i < 8; i++) {
-			COPY_4X1_LINE(d_dst + 0, d_dst + tmp2);
-			COPY_4X1_LINE(d_dst + 4, d_dst + tmp2 + 4);
+			COPY_8X1_LINE(d_dst, d_dst + tmp2);
 			d_dst += _d_pitch;
 		}
 	} else {
 		byte t = _paramPtr[code];
 		for (i = 0; i < 8; i++) {
-			FILL_4X1_LINE(d_dst, t);
-			FILL_4X1_LINE(d_dst + 4, t);
+			FILL_8X1_LINE(d_dst, t);
 			d_dst += _d_pitch;
 		}
 	}
@@ -528,7 +542,9 @@ Codec47Decoder::Codec47Decoder(int width, int height) {
 	_height = height;
 	_tableBig = (byte *)malloc(256 * 388);
 	_tableSmall = (byte *)malloc(256 * 128);
-	if ((_tableBig != nullptr) && (_tableSmall != nullptr)) {
+	_patternBig = (byte *)malloc(256 * 64);
+	_patternSmall = (byte *)malloc(256 * 16);
+	if ((_tableBig != nullptr) && (_tableSmall != nullptr) && (_patternBig != nullptr) && (_patternSmall != nullptr)) {
 		makeTablesInterpolation(4);
 		makeTablesInterpolation(8);
 	}
@@ -550,6 +566,10 @@ Codec47Decoder::~Codec47Decoder() {
 		free(_tableSmall);
 		_tableSmall = nullptr;
 	}
+	free(_patternBig);
+	_patternBig = nullptr;
+	free(_patternSmall);
+	_patternSmall = nullptr;
 	_lastTableWidth = -1;
 	if (_deltaBuf) {
 		free(_deltaBuf);
@@ -561,7 +581,7 @@ Codec47Decoder::~Codec47Decoder() {
 }
 
 bool Codec47Decoder::decode(byte *dst, const byte *src) {
-	if ((_tableBig == nullptr) || (_tableSmall == nullptr) || (_deltaBuf == nullptr))
+	if ((_tableBig == nullptr) || (_tableSmall == nullptr) || (_patternBig == nullptr) || (_patternSmall == nullptr) || (_deltaBuf == nullptr))
 		return false;
 
 	_offset1 = _deltaBufs[1] - _curBuf;
@@ -40,6 +40,10 @@ private:
 	int32 _offset1, _offset2;
 	byte *_tableBig;
 	byte *_tableSmall;
+	// Per-pattern masks for the 8x8 and 4x4 two-color fills, one byte per
+	// pixel, 0xFF for pixels taking the first color
+	byte *_patternBig;
+	byte *_patternSmall;
 	int16 _table[256];
 	int32 _frameSize;
 	int _width, _height;
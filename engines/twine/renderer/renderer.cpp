@@ -490,7 +490,8 @@ bool Renderer::computePolygons(int16 polyRenderType, const Vertex *vertices, int
 	return true;
 }
 
-void Renderer::renderPolygonsCopper(int vtop, int32 vsize, uint16 color) const {
+template<typename SpanFunc>
+void Renderer::renderPolygonLines(int vtop, int32 vsize, SpanFunc &span) const {
 	uint8 *out = (uint8 *)_engine->_frontVideoBuffer.getBasePtr(0, vtop);
 	const int16 *ptr1 = &_polyTab[vtop];
 	const int screenWidth = _engine->width();
@@ -504,17 +505,23 @@ void Renderer::renderPolygonsCopper(int vtop, int32 vsize, uint16 color) const {
 	if (renderLoop > screenHeight) {
 		renderLoop = screenHeight;
 	}
-	int32 sens = 1;
-
 	for (int32 currentLine = 0; currentLine < renderLoop; ++currentLine) {
-		int16 xMin = ptr1[0];
-		int16 xMax = ptr1[screenHeight];
-
+		// the left edge is in the first half of the polygon tab, the right one in the second
+		span(out, ptr1[0], ptr1[screenHeight]);
 		ptr1++;
-		uint8 *pDest = out + xMin;
+		out += screenWidth;
+	}
+}
 
-		for (; xMin <= xMax; xMin++) {
-			*pDest++ = (uint8)color;
+namespace {
+
+struct CopperSpan {
+	uint16 color;
+	int32 sens = 1;
+
+	void operator()(uint8 *out, int16 xMin, int16 xMax) {
+		if (xMin <= xMax) {
+			memset(out + xMin, (uint8)color, xMax - xMin + 1);
 		}
 
 		color += sens;
@@ -524,34 +531,17 @@ void Renderer::renderPolygonsCopper(int vtop, int32 vsize, uint16 color) const {
 				color += sens;
 			}
 		}
-		out += screenWidth;
 	}
-}
+};
 
-void Renderer::renderPolygonsBopper(int vtop, int32 vsize, uint16 color) const {
-	uint8 *out = (uint8 *)_engine->_frontVideoBuffer.getBasePtr(0, vtop);
-	const int16 *ptr1 = &_polyTab[vtop];
-	const int screenWidth = _engine->width();
-	const int screenHeight = _engine->height();
-	int32 renderLoop = vsize;
-	if (vtop < 0) {
-		out += screenWidth * ABS(vtop);
-		renderLoop -= ABS(vtop);
-	}
-	if (renderLoop > screenHeight) {
-		renderLoop = screenHeight;
-	}
+struct BopperSpan {
+	uint16 color;
 	int32 sens = 1;
 	int32 line = 2;
-	for (int32 currentLine = 0; currentLine < renderLoop; ++currentLine) {
-		int16 xMin = ptr1[0];
-		int16 xMax = ptr1[screenHeight];
-		ptr1++;
 
-		uint8 *pDest = out + xMin;
-
-		for (; xMin <= xMax; xMin++) {
-			*pDest++ = (uint8)color;
+	void operator()(uint8 *out, int16 xMin, int16 xMax) {
+		if (xMin <= xMax) {
+			memset(out + xMin, (uint8)color, xMax - xMin + 1);
 		}
 
 		line--;
@@ -565,64 +555,31 @@ void Renderer::renderPolygonsBopper(int vtop, int32 vsize, uint16 color) const {
 				}
 			}
 		}
-		out += screenWidth;
 	}
-}
+};
 
-void Renderer::renderPolygonsFlat(int vtop, int32 vsize, uint16 color) const {
-	uint8 *out = (uint8 *)_engine->_frontVideoBuffer.getBasePtr(0, vtop);
-	const int16 *ptr1 = &_polyTab[vtop];
-	const int screenWidth = _engine->width();
-	const int screenHeight = _engine->height();
-	int32 renderLoop = vsize;
-	if (vtop < 0) {
-		out += screenWidth * ABS(vtop);
-		renderLoop -= ABS(vtop);
-	}
-	if (renderLoop > screenHeight) {
-		renderLoop = screenHeight;
-	}
-	for (int32 currentLine = 0; currentLine < renderLoop; ++currentLine) {
-		const int16 start = ptr1[0];
-		const int16 stop = ptr1[screenHeight];
-		ptr1++;
-		const int32 hsize = stop - start;
+struct FlatSpan {
+	uint8 color;
+	int screenWidth;
 
-		for (int32 j = start; j <= hsize + start; j++) {
-			if (j >= 0 && j < screenWidth) {
-				out[j] = color;
-			}
+	void operator()(uint8 *out, int16 start, int16 stop) {
+		const int32 xMin = MAX<int32>(start, 0);
+		const int32 xMax = MIN<int32>(stop, screenWidth - 1);
+		if (xMin <= xMax) {
+			memset(out + xMin, color, xMax - xMin + 1);
 		}
-		out += screenWidth;
 	}
-}
+};
 
 #define ROL16(x, b) (((x) << (b)) | ((x) >> (16 - (b))))
 
-void Renderer::renderPolygonsTele(int vtop, int32 vsize, uint16 color) const {
-	uint8 *out = (uint8 *)_engine->_frontVideoBuffer.getBasePtr(0, vtop);
-	const int16 *ptr1 = &_polyTab[vtop];
-	const int screenWidth = _engine->width();
-	const int screenHeight = _engine->height();
-
-	int32 renderLoop = vsize;
-	if (vtop < 0) {
-		out += screenWidth * ABS(vtop);
-		renderLoop -= ABS(vtop);
-	}
-	if (renderLoop > screenHeight) {
-		renderLoop = screenHeight;
-	}
-
+struct TeleSpan {
+	uint16 color;
 	uint16 acc = 17371;
-	color &= 0xFF;
-	uint16 col;
-	for (int32 currentLine = 0; currentLine < renderLoop; ++currentLine) {
-		int16 xMin = ptr1[0];
-		int16 xMax = ptr1[screenHeight];
-		++ptr1;
+
+	void operator()(uint8 *out, int16 xMin, int16 xMax) {
 		uint8 *pDest = out + xMin;
-		col = xMin;
+		uint16 col = xMin;
 
 		for (; xMin <= xMax; xMin++) {
 			col = ((col + acc) & 0xFF03) + (uint16)color;
@@ -630,53 +587,26 @@ void Renderer::renderPolygonsTele(int vtop, int32 vsize, uint16 color) const {
 
 			*pDest++ = (uint8)col;
 		}
-		out += screenWidth;
 	}
-}
+};
 
-void Renderer::renderPolygonsTrans(int vtop, int32 vsize, uint16 color) const {
-	uint8 *out = (uint8 *)_engine->_frontVideoBuffer.getBasePtr(0, vtop);
-	const int16 *ptr1 = &_polyTab[vtop];
-	const int screenWidth = _engine->width();
-	const int screenHeight = _engine->height();
-
-	do {
-		int16 start = ptr1[0];
-		int16 stop = ptr1[screenHeight];
-
-		ptr1++;
-		int32 hsize = stop - start;
+struct TransSpan {
+	uint16 color;
 
-		if (hsize >= 0) {
-			hsize++;
+	void operator()(uint8 *out, int16 start, int16 stop) {
+		if (stop - start >= 0) {
 			uint8 *out2 = start + out;
 			*out2 = (*(out2)&0x0F) | color;
-			out2++;
 		}
-		out += screenWidth;
-	} while (--vsize);
-}
+	}
+};
 
 // Used e.g for the legs of the horse or the ears of most characters
-void Renderer::renderPolygonsTrame(int vtop, int32 vsize, uint16 color) const {
-	uint8 *out = (uint8 *)_engine->_frontVideoBuffer.getBasePtr(0, vtop);
-	const int16 *ptr1 = &_polyTab[vtop];
-	const int screenWidth = _engine->width();
-	const int screenHeight = _engine->height();
-
-	int32 renderLoop = vsize;
-	if (vtop < 0) {
-		out += screenWidth * ABS(vtop);
-		renderLoop -= ABS(vtop);
-	}
-	if (renderLoop > screenHeight) {
-		renderLoop = screenHeight;
-	}
+struct TrameSpan {
+	uint16 color;
 	int32 pair = 0;
-	for (int32 currentLine = 0; currentLine < renderLoop; ++currentLine) {
-		int16 start = ptr1[0];
-		int16 stop = ptr1[screenHeight];
-		ptr1++;
+
+	void operator()(uint8 *out, int16 start, int16 stop) {
 		uint8 *out2 = start + out;
 		stop = ((stop - start) + 1) / 2;
 		if (stop > 0) {
@@ -690,40 +620,24 @@ void Renderer::renderPolygonsTrame(int vtop, int32 vsize, uint16 color) const {
 				out2 += 2;
 			}
 		}
-
-		out += screenWidth;
 	}
-}
+};
 
-void Renderer::renderPolygonsGouraud(int vtop, int32 vsize) const {
-	uint8 *out = (uint8 *)_engine->_frontVideoBuffer.getBasePtr(0, vtop);
-	const int16 *ptr1 = &_polyTab[vtop];
-	const int16 *ptr2 = &_colorProgressionBuffer[vtop];
-	const int screenWidth = _engine->width();
-	const int screenHeight = _engine->height();
-	int32 renderLoop = vsize;
-	if (vtop < 0) {
-		out += screenWidth * ABS(vtop);
-		renderLoop -= ABS(vtop);
-	}
-	if (renderLoop > screenHeight) {
-		renderLoop = screenHeight;
-	}
-	for (int32 currentLine = 0; currentLine < renderLoop; ++currentLine) {
+struct GouraudSpan {
+	const int16 *ptr2; // color progression of the current line
+	int screenWidth;
+	int screenHeight;
+
+	void operator()(uint8 *out, int16 start, int16 stop) {
 		uint16 startColor = ptr2[0];
 		const uint16 stopColor = ptr2[screenHeight];
+		ptr2++;
 
 		int16 colorDiff = stopColor - startColor;
 
-		const int16 stop = ptr1[screenHeight];
-		const int16 start = ptr1[0];
-
-		ptr1++;
 		uint8 *out2 = start + out;
 		int32 hsize = stop - start;
 
-		ptr2++;
-
 		if (hsize == 0) {
 			if (start >= 0 && start < screenWidth) {
 				*out2 = ((startColor + stopColor) / 2) / 256; // average of the 2 colors
@@ -774,34 +688,19 @@ void Renderer::renderPolygonsGouraud(int vtop, int32 vsize) const {
 				}
 			} while (--hsize);
 		}
-		out += screenWidth;
 	}
-}
+};
 
 // used for the most of the heads of the characters and the horse body
-void Renderer::renderPolygonsDither(int vtop, int32 vsize) const {
-	uint8 *out = (uint8 *)_engine->_frontVideoBuffer.getBasePtr(0, vtop);
-	const int16 *ptr1 = &_polyTab[vtop];
-	const int16 *ptr2 = &_colorProgressionBuffer[vtop];
-	const int screenWidth = _engine->width();
-	const int screenHeight = _engine->height();
+struct DitherSpan {
+	const int16 *ptr2; // color progression, only advanced for lines that are drawn
+	int screenWidth;
+	int screenHeight;
 
-	int32 renderLoop = vsize;
-	if (vtop < 0) {
-		out += screenWidth * ABS(vtop);
-		renderLoop -= ABS(vtop);
-	}
-	if (renderLoop > screenHeight) {
-		renderLoop = screenHeight;
-	}
-	for (int32 currentLine = 0; currentLine < renderLoop; ++currentLine) {
-		int16 stop = ptr1[screenHeight];
-		int16 start = ptr1[0];
-		ptr1++;
+	void operator()(uint8 *out, int16 start, int16 stop) {
 		int32 hsize = stop - start;
 		if (hsize < 0) {
-			out += screenWidth;
-			continue;
+			return;
 		}
 		uint16 startColor = ptr2[0];
 		uint16 stopColor = ptr2[screenHeight];
@@ -908,80 +807,116 @@ void Renderer::renderPolygonsDither(int vtop, int32 vsize) const {
 				} while (--hsize);
 			}
 		}
-		out += screenWidth;
 	}
-}
+};
 
-void Renderer::renderPolygonsMarble(int vtop, int32 vsize, uint16 color) const {
-	const int screenWidth = _engine->width();
-	const int screenHeight = _engine->height();
+struct MarbleSpan {
+	uint16 start;
+	uint16 end;
+	uint16 delta; // delta intensity
 
-	uint8 *out = (uint8 *)_engine->_frontVideoBuffer.getBasePtr(0, vtop);
-	int16 *ptr1 = &_polyTab[vtop];
-
-	int16 xMin, xMax;
-	int16 y = vtop;
-	uint8 *pDestLine = out;
-	uint8 *pDest;
-	int16 *pVerticG = ptr1;
-	int16 *pVerticD = &ptr1[screenHeight];
-
-	uint16 start = (color & 0xFF) << 8;
-	uint16 end = color & 0xFF00;
-	uint16 delta = end - start + 1; // delta intensity
-	int32 step, dc;
-
-	for (; y <= vsize; y++) {
-		xMin = *pVerticG++;
-		xMax = *pVerticD++;
-		pDest = pDestLine + xMin;
-
-		dc = xMax - xMin;
+	void operator()(uint8 *out, int16 xMin, int16 xMax) {
+		uint8 *pDest = out + xMin;
+
+		const int32 dc = xMax - xMin;
 		if (dc == 0) {
 			// just one
 			*pDest++ = (uint8)(end >> 8);
 		} else if (dc > 0) {
-			step = delta / (dc + 1);
-			color = start;
+			const int32 step = delta / (dc + 1);
+			uint16 color = start;
 
 			for (; xMin <= xMax; xMin++) {
 				*pDest++ = (uint8)(color >> 8);
 				color += step;
 			}
 		}
-
-		pDestLine += screenWidth;
 	}
+};
+
+struct SimplifiedSpan {
+	const int16 *ptr2; // color progression of the current line
+	int screenWidth;
+
+	void operator()(uint8 *out, int16 start, int16 stop) {
+		const int16 xMin = MAX<int16>(0, start);
+		const int16 xMax = MIN<int16>((int16)(screenWidth - 1), stop);
+		const uint8 color = (*ptr2++) >> 8;
+		if (xMin <= xMax) {
+			memset(out + xMin, color, xMax - xMin + 1);
+		}
+	}
+};
+
+} // namespace
+
+void Renderer::renderPolygonsCopper(int vtop, int32 vsize, uint16 color) const {
+	CopperSpan span;
+	span.color = color;
+	renderPolygonLines(vtop, vsize, span);
 }
 
-void Renderer::renderPolygonsSimplified(int vtop, int32 vsize, uint16 color) const {
-	uint8 *out = (uint8 *)_engine->_frontVideoBuffer.getBasePtr(0, vtop);
-	const int16 *ptr1 = &_polyTab[vtop];
-	const int16 *ptr2 = &_colorProgressionBuffer[vtop];
-	const int screenWidth = _engine->width();
-	const int screenHeight = _engine->height();
+void Renderer::renderPolygonsBopper(int vtop, int32 vsize, uint16 color) const {
+	BopperSpan span;
+	span.color = color;
+	renderPolygonLines(vtop, vsize, span);
+}
 
-	int32 renderLoop = vsize;
-	if (vtop < 0) {
-		out += screenWidth * ABS(vtop);
-		renderLoop -= ABS(vtop);
-	}
-	if (renderLoop > screenHeight) {
-		renderLoop = screenHeight;
-	}
-	for (int32 currentLine = 0; currentLine < renderLoop; ++currentLine) {
-		int16 xMin = MAX<int16>(0, ptr1[0]);
-		const int16 xMax = MIN<int16>((int16)(screenWidth - 1), ptr1[screenHeight]);
-		uint8 *pDest = out + xMin;
+void Renderer::renderPolygonsFlat(int vtop, int32 vsize, uint16 color) const {
+	FlatSpan span;
+	span.color = (uint8)color;
+	span.screenWidth = _engine->width();
+	renderPolygonLines(vtop, vsize, span);
+}
 
-		color = (*ptr2++) >> 8;
-		for (; xMin <= xMax; xMin++) {
-			*pDest++ = color;
-		}
-		++ptr1;
+void Renderer::renderPolygonsTele(int vtop, int32 vsize, uint16 color) const {
+	TeleSpan span;
+	span.color = color & 0xFF;
+	renderPolygonLines(vtop, vsize, span);
+}
 
-		out += screenWidth;
-	}
+void Renderer::renderPolygonsTrans(int vtop, int32 vsize, uint16 color) const {
+	TransSpan span;
+	span.color = color;
+	renderPolygonLines(vtop, vsize, span);
+}
+
+void Renderer::renderPolygonsTrame(int vtop, int32 vsize, uint16 color) const {
+	TrameSpan span;
+	span.color = color;
+	renderPolygonLines(vtop, vsize, span);
+}
+
+void Renderer::renderPolygonsGouraud(int vtop, int32 vsize) const {
+	GouraudSpan span;
+	span.ptr2 = &_colorProgressionBuffer[vtop];
+	span.screenWidth = _engine->width();
+	span.screenHeight = _engine->height();
+	renderPolygonLines(vtop, vsize, span);
+}
+
+void Renderer::renderPolygonsDither(int vtop, int32 vsize) const {
+	DitherSpan span;
+	span.ptr2 = &_colorProgressionBuffer[vtop];
+	span.screenWidth = _engine->width();
+	span.screenHeight = _engine->height();
+	renderPolygonLines(vtop, vsize, span);
+}
+
+void Renderer::renderPolygonsMarble(int vtop, int32 vsize, uint16 color) const {
+	MarbleSpan span;
+	span.start = (color & 0xFF) << 8;
+	span.end = color & 0xFF00;
+	span.delta = span.end - span.start + 1;
+	// the lines from vtop up to vsize are drawn here
+	renderPolygonLines(vtop, vsize - vtop + 1, span);
+}
+
+void Renderer::renderPolygonsSimplified(int vtop, int32 vsize, uint16 color) const {
+	SimplifiedSpan span;
+	span.ptr2 = &_colorProgressionBuffer[vtop];
+	span.screenWidth = _engine->width();
+	renderPolygonLines(vtop, vsize, span);
 }
 
 void Renderer::renderPolygons(const CmdRenderPolygon &polygon, Vertex *vertices, int vtop, int vbottom) {
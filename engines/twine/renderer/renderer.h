@@ -195,6 +195,13 @@ private:
 
 	bool _isUsingOrthoProjection = false;
 
+	/**
+	 * Walks the lines of the polygon in the polygon tab and hands the span of each
+	 * line to the given span function, which does the shading.
+	 */
+	template<typename SpanFunc>
+	void renderPolygonLines(int vtop, int32 vsize, SpanFunc &span) const;
+
 	void renderPolygonsCopper(int vtop, int32 vsize, uint16 color) const;
 	void renderPolygonsBopper(int vtop, int32 vsize, uint16 color) const;
 	void renderPolygonsFlat(int vtop, int32 vsize, uint16 color) const;
@@ -32,6 +32,9 @@
 #include "ultima/ultima8/world/missile_tracker.h"
 
 #include "ultima/ultima8/world/actors/pathfinder_process.h"
+#include "ultima/ultima8/graphics/fonts/rendered_text.h"
+#include "ultima/ultima8/graphics/fonts/font.h"
+#include "ultima/ultima8/graphics/fonts/font_manager.h"
 
 // map dumping
 
@@ -41,6 +44,7 @@ namespace Ultima8 {
 DEFINE_RUNTIME_CLASSTYPE_CODE(GameMapGump)
 
 bool GameMapGump::_highlightItems = false;
+bool GameMapGump::_showSortStats = false;
 
 GameMapGump::GameMapGump() :
 	Gump(), _displayDragging(false), _displayList(0), _draggingShape(0),
@@ -166,6 +170,26 @@ void GameMapGump::PaintThis(RenderSurface *surf, int32 lerp_factor, bool scaled)
 
 
 	_displayList->PaintDisplayList(_highlightItems);
+
+	if (_showSortStats)
+		PaintSortStats(surf);
+}
+
+void GameMapGump::PaintSortStats(RenderSurface *surf) {
+	Font *font = FontManager::get_instance()->getGameFont(0, true);
+	if (!font)
+		return;
+
+	const ItemSorter::SortStats &stats = _displayList->getStats();
+	char buf[100];
+	sprintf(buf, "Sort: %u items, %u/%u tests, %s, %u ms", stats._items,
+			stats._tests, stats._bruteTests,
+			stats._reused ? "reused" : "rebuilt", stats._time);
+
+	unsigned int remaining;
+	RenderedText *rendtext = font->renderText(buf, remaining);
+	rendtext->draw(surf, _dims.left + 2, _dims.top + 2);
+	delete rendtext;
 }
 
 // Trace a click, and return ObjId
@@ -85,6 +85,12 @@ public:
 	static bool is_highlightItems() {
 		return _highlightItems;
 	}
+	static void Set_showSortStats(bool show) {
+		_showSortStats = show;
+	}
+	static bool is_showSortStats() {
+		return _showSortStats;
+	}
 
 	void        RenderSurfaceChanged() override;
 
@@ -96,6 +102,9 @@ protected:
 	int32 _draggingPos[3];
 
 	static bool _highlightItems;
+	static bool _showSortStats;
+
+	void PaintSortStats(RenderSurface *surf);
 };
 
 } // End of namespace Ultima8
@@ -25,6 +25,8 @@
 #include "ultima/ultima8/misc/id_man.h"
 #include "ultima/ultima8/ultima8.h"
 
+#include "common/system.h"
+
 namespace Ultima {
 namespace Ultima8 {
 
@@ -42,11 +44,13 @@ const uint16 Kernel::PROC_TYPE_ALL = 6;
 static const uint16 CRU_PROC_TYPE_ALL = 0xc;
 
 Kernel::Kernel() : _loading(false), _tickNum(0), _paused(0),
-		_runningProcess(nullptr), _frameByFrame(false) {
+		_runningProcess(nullptr), _frameByFrame(false), _waitQueueDirty(false),
+		_profiling(false), _profileStart(0) {
 	debugN(MM_INFO, "Creating Kernel...\n");
 
 	_kernel = this;
 	_pIDs = new idMan(1, 32766, 128);
+	_pidTable.resize(32767);
 	_currentProcess = _processes.end();
 }
 
@@ -65,9 +69,15 @@ void Kernel::reset() {
 	for (ProcessIterator it = _processes.begin(); it != _processes.end(); ++it) {
 		delete(*it);
 	}
+	for (ProcessIterator it = _waitQueue.begin(); it != _waitQueue.end(); ++it) {
+		delete(*it);
+	}
 	_processes.clear();
+	_waitQueue.clear();
+	_waitQueueDirty = false;
 	_currentProcess = _processes.begin();
 
+	Common::fill(_pidTable.begin(), _pidTable.end(), (Process *)nullptr);
 	_pIDs->clearAll();
 
 	_paused = 0;
@@ -125,6 +135,7 @@ ProcId Kernel::addProcessExec(Process *proc) {
 
 	_processes.push_back(proc);
 	proc->_flags |= Process::PROC_ACTIVE;
+	_pidTable[proc->_pid] = proc;
 
 	Process *oldrunning = _runningProcess;
 	_runningProcess = proc;
@@ -138,7 +149,10 @@ void Kernel::runProcesses() {
 	if (!_paused)
 		_tickNum++;
 
-	if (_processes.size() == 0) {
+	if (_waitQueueDirty)
+		sweepWaitQueue();
+
+	if (_processes.size() == 0 && _waitQueue.size() == 0) {
 		warning("Process queue is empty?! Aborting.");
 		return;
 	}
@@ -158,7 +172,17 @@ void Kernel::runProcesses() {
 		        (!_paused || (p->_flags & Process::PROC_RUNPAUSED)) &&
 				(_paused || _tickNum % p->getTicksPerRun() == 0)) {
 			_runningProcess = p;
-			p->run();
+			if (_profiling) {
+				// Grab the name first, the process may be gone after running
+				const char *className = p->GetClassType()._className;
+				uint32 start = g_system->getMillis();
+				p->run();
+				ProcessProfile &profile = _profile[className];
+				profile._runs++;
+				profile._time += g_system->getMillis() - start;
+			} else {
+				p->run();
+			}
 
 			num_run++;
 
@@ -193,6 +217,8 @@ void Kernel::runProcesses() {
 			_currentProcess = _processes.erase(_currentProcess);
 
 			// Clear pid
+			if (_pidTable[p->_pid] == p)
+				_pidTable[p->_pid] = nullptr;
 			_pIDs->clearID(p->_pid);
 
 			//! is this the right place to delete processes?
@@ -208,6 +234,14 @@ void Kernel::runProcesses() {
 			//
 			_processes.push_back(p);
 			_currentProcess = _processes.erase(_currentProcess);
+		} else if (p->is_suspended() &&
+		           !(p->_flags & (Process::PROC_TERMINATED | Process::PROC_TERM_DEFERRED))) {
+			// Park the process until it is woken up or terminated. A process
+			// whose termination is pending stays here, as the terminate is
+			// skipped while paused and the wait queue is only swept when a
+			// parked process is terminated.
+			_waitQueue.push_back(p);
+			_currentProcess = _processes.erase(_currentProcess);
 		} else {
 			++_currentProcess;
 		}
@@ -220,15 +254,10 @@ void Kernel::setNextProcess(Process *proc) {
 	if (_currentProcess != _processes.end() && *_currentProcess == proc) return;
 
 	if (proc->_flags & Process::PROC_ACTIVE) {
-		for (ProcessIterator it = _processes.begin();
-		        it != _processes.end(); ++it) {
-			if (*it == proc) {
-				_processes.erase(it);
-				break;
-			}
-		}
+		unlinkProcess(proc);
 	} else {
 		proc->_flags |= Process::PROC_ACTIVE;
+		_pidTable[proc->_pid] = proc;
 	}
 
 	if (_currentProcess == _processes.end()) {
@@ -242,26 +271,70 @@ void Kernel::setNextProcess(Process *proc) {
 	}
 }
 
-Process *Kernel::getProcess(ProcId pid) {
+void Kernel::unlinkProcess(Process *proc) {
+	// Processes being woken up are usually in the wait queue, so check it first
+	for (ProcessIterator it = _waitQueue.begin(); it != _waitQueue.end(); ++it) {
+		if (*it == proc) {
+			_waitQueue.erase(it);
+			return;
+		}
+	}
 	for (ProcessIterator it = _processes.begin(); it != _processes.end(); ++it) {
+		if (*it == proc) {
+			_processes.erase(it);
+			return;
+		}
+	}
+}
+
+void Kernel::sweepWaitQueue() {
+	ProcessIterator it = _waitQueue.begin();
+	while (it != _waitQueue.end()) {
 		Process *p = *it;
-		if (p->_pid == pid)
-			return p;
+		if (p->_flags & (Process::PROC_TERMINATED | Process::PROC_TERM_DEFERRED)) {
+			_processes.push_back(p);
+			it = _waitQueue.erase(it);
+		} else {
+			++it;
+		}
 	}
+	// Terminations are not carried out while paused, so check again next time
+	if (!_paused)
+		_waitQueueDirty = false;
+}
+
+Process *Kernel::getProcess(ProcId pid) {
+	if (pid < _pidTable.size())
+		return _pidTable[pid];
 	return nullptr;
 }
 
+void Kernel::getProcesses(ObjId objid, Std::vector<Process *> &procs) const {
+	const Std::list<Process *> *lists[] = { &_processes, &_waitQueue };
+	for (int i = 0; i < ARRAYSIZE(lists); ++i) {
+		for (ProcessIter it = lists[i]->begin(); it != lists[i]->end(); ++it) {
+			Process *p = *it;
+			if (!p->is_terminated() && (objid == 0 || objid == p->_itemNum))
+				procs.push_back(p);
+		}
+	}
+}
+
 void Kernel::kernelStats() {
 	g_debugger->debugPrintf("Kernel memory stats:\n");
-	g_debugger->debugPrintf("Processes  : %u/32765\n", _processes.size());
+	g_debugger->debugPrintf("Processes  : %u/32765 (%u waiting)\n",
+		_processes.size() + _waitQueue.size(), _waitQueue.size());
 }
 
 void Kernel::processTypes() {
 	g_debugger->debugPrintf("Current process types:\n");
 	Std::map<Common::String, unsigned int> processtypes;
-	for (ProcessIterator it = _processes.begin(); it != _processes.end(); ++it) {
-		Process *p = *it;
-		processtypes[p->GetClassType()._className]++;
+	const Std::list<Process *> *lists[] = { &_processes, &_waitQueue };
+	for (int i = 0; i < ARRAYSIZE(lists); ++i) {
+		for (ProcessIter it = lists[i]->begin(); it != lists[i]->end(); ++it) {
+			const Process *p = *it;
+			processtypes[p->GetClassType()._className]++;
+		}
 	}
 	Std::map<Common::String, unsigned int>::const_iterator iter;
 	for (iter = processtypes.begin(); iter != processtypes.end(); ++iter) {
@@ -272,30 +345,36 @@ void Kernel::processTypes() {
 uint32 Kernel::getNumProcesses(ObjId objid, uint16 processtype) {
 	uint32 count = 0;
 
-	for (ProcessIterator it = _processes.begin(); it != _processes.end(); ++it) {
-		Process *p = *it;
+	const Std::list<Process *> *lists[] = { &_processes, &_waitQueue };
+	for (int i = 0; i < ARRAYSIZE(lists); ++i) {
+		for (ProcessIter it = lists[i]->begin(); it != lists[i]->end(); ++it) {
+			const Process *p = *it;
 
-		// Don't count us, we are not really here
-		if (p->is_terminated()) continue;
+			// Don't count us, we are not really here
+			if (p->is_terminated()) continue;
 
-		if ((objid == 0 || objid == p->_itemNum) &&
-		        (processtype == PROC_TYPE_ALL || processtype == p->_type))
-			count++;
+			if ((objid == 0 || objid == p->_itemNum) &&
+			        (processtype == PROC_TYPE_ALL || processtype == p->_type))
+				count++;
+		}
 	}
 
 	return count;
 }
 
 Process *Kernel::findProcess(ObjId objid, uint16 processtype) {
-	for (ProcessIterator it = _processes.begin(); it != _processes.end(); ++it) {
-		Process *p = *it;
+	Std::list<Process *> *lists[] = { &_processes, &_waitQueue };
+	for (int i = 0; i < ARRAYSIZE(lists); ++i) {
+		for (ProcessIterator it = lists[i]->begin(); it != lists[i]->end(); ++it) {
+			Process *p = *it;
 
-		// Don't count us, we are not really here
-		if (p->is_terminated()) continue;
+			// Don't count us, we are not really here
+			if (p->is_terminated()) continue;
 
-		if ((objid == 0 || objid == p->_itemNum) &&
-		        (processtype == PROC_TYPE_ALL || processtype == p->_type)) {
-			return p;
+			if ((objid == 0 || objid == p->_itemNum) &&
+			        (processtype == PROC_TYPE_ALL || processtype == p->_type)) {
+				return p;
+			}
 		}
 	}
 
@@ -304,55 +383,118 @@ Process *Kernel::findProcess(ObjId objid, uint16 processtype) {
 
 
 void Kernel::killProcesses(ObjId objid, uint16 processtype, bool fail) {
-	for (ProcessIterator it = _processes.begin(); it != _processes.end(); ++it) {
-		Process *p = *it;
-
-		if (p->_itemNum != 0 && (objid == 0 || objid == p->_itemNum) &&
-		        (processtype == PROC_TYPE_ALL || processtype == p->_type) &&
-		        !(p->_flags & Process::PROC_TERMINATED) &&
-		        !(p->_flags & Process::PROC_TERM_DEFERRED)) {
-			if (fail)
-				p->fail();
-			else
-				p->terminate();
+	// Terminating a process never removes it from its list, so the
+	// iterators stay valid even if waiting processes get woken up.
+	Std::list<Process *> *lists[] = { &_processes, &_waitQueue };
+	for (int i = 0; i < ARRAYSIZE(lists); ++i) {
+		for (ProcessIterator it = lists[i]->begin(); it != lists[i]->end(); ++it) {
+			Process *p = *it;
+
+			if (p->_itemNum != 0 && (objid == 0 || objid == p->_itemNum) &&
+			        (processtype == PROC_TYPE_ALL || processtype == p->_type) &&
+			        !(p->_flags & Process::PROC_TERMINATED) &&
+			        !(p->_flags & Process::PROC_TERM_DEFERRED)) {
+				if (fail)
+					p->fail();
+				else
+					p->terminate();
+			}
 		}
 	}
 }
 
 void Kernel::killProcessesNotOfType(ObjId objid, uint16 processtype, bool fail) {
-	for (ProcessIterator it = _processes.begin(); it != _processes.end(); ++it) {
-		Process *p = *it;
-
-		if (p->_itemNum != 0 && (objid == 0 || objid == p->_itemNum) &&
-		        (p->_type != processtype) &&
-		        !(p->_flags & Process::PROC_TERMINATED) &&
-		        !(p->_flags & Process::PROC_TERM_DEFERRED)) {
-			if (fail)
-				p->fail();
-			else
-				p->terminate();
+	Std::list<Process *> *lists[] = { &_processes, &_waitQueue };
+	for (int i = 0; i < ARRAYSIZE(lists); ++i) {
+		for (ProcessIterator it = lists[i]->begin(); it != lists[i]->end(); ++it) {
+			Process *p = *it;
+
+			if (p->_itemNum != 0 && (objid == 0 || objid == p->_itemNum) &&
+			        (p->_type != processtype) &&
+			        !(p->_flags & Process::PROC_TERMINATED) &&
+			        !(p->_flags & Process::PROC_TERM_DEFERRED)) {
+				if (fail)
+					p->fail();
+				else
+					p->terminate();
+			}
 		}
 	}
 }
 
+void Kernel::setProfiling(bool profiling) {
+	if (profiling && !_profiling) {
+		_profile.clear();
+		_profileStart = g_system->getMillis();
+	}
+	_profiling = profiling;
+}
+
+namespace {
+
+struct ProfileEntry {
+	Common::String _className;
+	uint32 _runs;
+	uint32 _time;
+};
+
+bool ProfileEntryMoreTime(const ProfileEntry &a, const ProfileEntry &b) {
+	if (a._time != b._time)
+		return a._time > b._time;
+	return a._runs > b._runs;
+}
+
+} // End of anonymous namespace
+
+void Kernel::processProfile() {
+	if (_profile.empty()) {
+		g_debugger->debugPrintf("No process profile collected%s\n",
+			_profiling ? " yet" : ", use Kernel::toggleProfile to start");
+		return;
+	}
+
+	Std::vector<ProfileEntry> entries;
+	uint32 total = 0;
+	Std::map<Common::String, ProcessProfile>::const_iterator iter;
+	for (iter = _profile.begin(); iter != _profile.end(); ++iter) {
+		ProfileEntry entry;
+		entry._className = iter->_key;
+		entry._runs = iter->_value._runs;
+		entry._time = iter->_value._time;
+		entries.push_back(entry);
+		total += entry._time;
+	}
+	Common::sort(entries.begin(), entries.end(), ProfileEntryMoreTime);
+
+	g_debugger->debugPrintf("Process run time by class (%u msec in processes, %u msec profiled):\n",
+		total, g_system->getMillis() - _profileStart);
+	for (Std::vector<ProfileEntry>::const_iterator it = entries.begin(); it != entries.end(); ++it) {
+		g_debugger->debugPrintf("%s: %u msec, %u runs\n",
+			it->_className.c_str(), it->_time, it->_runs);
+	}
+}
+
 void Kernel::save(Common::WriteStream *ws) {
 	ws->writeUint32LE(_tickNum);
 	_pIDs->save(ws);
-	ws->writeUint32LE(_processes.size());
-	for (ProcessIterator it = _processes.begin(); it != _processes.end(); ++it) {
-		const Std::string & classname = (*it)->GetClassType()._className; // virtual
-		assert(classname.size());
-
-		Std::map<Common::String, ProcessLoadFunc>::iterator iter;
-		iter = _processLoaders.find(classname);
+	ws->writeUint32LE(_processes.size() + _waitQueue.size());
+	const Std::list<Process *> *lists[] = { &_processes, &_waitQueue };
+	for (int i = 0; i < ARRAYSIZE(lists); ++i) {
+		for (ProcessIter it = lists[i]->begin(); it != lists[i]->end(); ++it) {
+			const Std::string & classname = (*it)->GetClassType()._className; // virtual
+			assert(classname.size());
+
+			Std::map<Common::String, ProcessLoadFunc>::iterator iter;
+			iter = _processLoaders.find(classname);
+
+			if (iter == _processLoaders.end()) {
+				error("Process class cannot save without registered loader: %s", classname.c_str());
+			}
 
-		if (iter == _processLoaders.end()) {
-			error("Process class cannot save without registered loader: %s", classname.c_str());
+			ws->writeUint16LE(classname.size());
+			ws->write(classname.c_str(), classname.size());
+			(*it)->saveData(ws);
 		}
-
-		ws->writeUint16LE(classname.size());
-		ws->write(classname.c_str(), classname.size());
-		(*it)->saveData(ws);
 	}
 }
 
@@ -367,6 +509,8 @@ bool Kernel::load(Common::ReadStream *rs, uint32 version) {
 		Process *p = loadProcess(rs, version);
 		if (!p) return false;
 		_processes.push_back(p);
+		if (p->getPid() < _pidTable.size())
+			_pidTable[p->getPid()] = p;
 	}
 
 	// Integrity check for processes
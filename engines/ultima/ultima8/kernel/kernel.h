@@ -83,17 +83,27 @@ public:
 	//! \param fail if true, fail the processes instead of terminating them
 	void killProcessesNotOfType(ObjId objid, uint16 processtype, bool fail);
 
-	//! get an iterator of the process list.
-	ProcessIter getProcessBeginIterator() {
-		return _processes.begin();
-	}
-	ProcessIter getProcessEndIterator() {
-		return _processes.end();
+	//! get all live (not terminated) processes of an object
+	//! \param objid the object, or 0 for any object
+	//! \param procs the list to add the processes to
+	void getProcesses(ObjId objid, Std::vector<Process *> &procs) const;
+
+	//! Note that a suspended process was terminated, so the wait queue
+	//! has to be checked for processes to clean up.
+	void suspendedProcessTerminated() {
+		_waitQueueDirty = true;
 	}
 
 	void kernelStats();
 	void processTypes();
 
+	//! Start or stop collecting run time per process class
+	void setProfiling(bool profiling);
+	bool isProfiling() const {
+		return _profiling;
+	}
+	void processProfile();
+
 	void save(Common::WriteStream *ws);
 	bool load(Common::ReadStream *rs, uint32 version);
 
@@ -138,7 +148,30 @@ public:
 private:
 	Process *loadProcess(Common::ReadStream *rs, uint32 version);
 
+	//! Find the list an active process is in and remove it from there
+	void unlinkProcess(Process *proc);
+
+	//! Move terminated processes out of the wait queue so they get cleaned up
+	void sweepWaitQueue();
+
+	struct ProcessProfile {
+		ProcessProfile() : _runs(0), _time(0) { }
+
+		uint32 _runs;
+		uint32 _time; //!< msec, summed over runs
+	};
+
+	//! Processes which can run, in the order they will be run
 	Std::list<Process *> _processes;
+
+	//! Suspended processes, moved here so they are not visited every tick.
+	//! They go back into _processes when woken up or terminated.
+	Std::list<Process *> _waitQueue;
+	bool _waitQueueDirty;
+
+	//! Active processes indexed by pid
+	Std::vector<Process *> _pidTable;
+
 	idMan   *_pIDs;
 
 	Std::list<Process *>::iterator _currentProcess;
@@ -153,6 +186,10 @@ private:
 
 	Process *_runningProcess;
 
+	bool _profiling;
+	uint32 _profileStart;
+	Std::map<Common::String, ProcessProfile> _profile;
+
 	static Kernel *_kernel;
 };
 
@@ -59,6 +59,17 @@ void Process::terminate() {
 	_waiting.clear();
 
 	_flags |= PROC_TERMINATED;
+
+	// suspended processes are parked by the kernel, make sure it cleans us up
+	if (_flags & PROC_SUSPENDED)
+		kernel->suspendedProcessTerminated();
+}
+
+void Process::terminateDeferred() {
+	_flags |= PROC_TERM_DEFERRED;
+
+	if (_flags & PROC_SUSPENDED)
+		Kernel::get_instance()->suspendedProcessTerminated();
 }
 
 void Process::wakeUp(uint32 result) {
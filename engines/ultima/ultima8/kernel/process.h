@@ -63,9 +63,7 @@ public:
 	virtual void terminate();
 
 	//! terminate next frame
-	void terminateDeferred() {
-		_flags |= PROC_TERM_DEFERRED;
-	}
+	void terminateDeferred();
 
 	//! run even when paused
 	void setRunPaused() {
@@ -139,6 +139,7 @@ Debugger::Debugger() : Shared::Debugger() {
 	registerCmd("GameMapGump::startHighlightItems", WRAP_METHOD(Debugger, cmdStartHighlightItems));
 	registerCmd("GameMapGump::stopHighlightItems", WRAP_METHOD(Debugger, cmdStopHighlightItems));
 	registerCmd("GameMapGump::toggleHighlightItems", WRAP_METHOD(Debugger, cmdToggleHighlightItems));
+	registerCmd("GameMapGump::toggleSortStats", WRAP_METHOD(Debugger, cmdToggleSortStats));
 	registerCmd("GameMapGump::dumpMap", WRAP_METHOD(Debugger, cmdDumpMap));
 	registerCmd("GameMapGump::dumpAllMaps", WRAP_METHOD(Debugger, cmdDumpAllMaps));
 	registerCmd("GameMapGump::incrementSortOrder", WRAP_METHOD(Debugger, cmdIncrementSortOrder));
@@ -147,6 +148,8 @@ Debugger::Debugger() : Shared::Debugger() {
 	registerCmd("Kernel::processTypes", WRAP_METHOD(Debugger, cmdProcessTypes));
 	registerCmd("Kernel::processInfo", WRAP_METHOD(Debugger, cmdProcessInfo));
 	registerCmd("Kernel::listProcesses", WRAP_METHOD(Debugger, cmdListProcesses));
+	registerCmd("Kernel::toggleProfile", WRAP_METHOD(Debugger, cmdToggleProfile));
+	registerCmd("Kernel::processProfile", WRAP_METHOD(Debugger, cmdProcessProfile));
 	registerCmd("Kernel::toggleFrameByFrame", WRAP_METHOD(Debugger, cmdToggleFrameByFrame));
 	registerCmd("Kernel::advanceFrame", WRAP_METHOD(Debugger, cmdAdvanceFrame));
 
@@ -663,6 +666,10 @@ bool Debugger::cmdToggleHighlightItems(int argc, const char **argv) {
 	GameMapGump::Set_highlightItems(!GameMapGump::is_highlightItems());
 	return false;
 }
+bool Debugger::cmdToggleSortStats(int argc, const char **argv) {
+	GameMapGump::Set_showSortStats(!GameMapGump::is_showSortStats());
+	return false;
+}
 
 void Debugger::dumpCurrentMap() {
 	// Increase number of available object IDs.
@@ -867,11 +874,13 @@ bool Debugger::cmdListProcesses(int argc, const char **argv) {
 		} else {
 			debugPrintf("Processes:\n");
 		}
-		for (ProcessIterator it = kern->_processes.begin();
-			it != kern->_processes.end(); ++it) {
-			Process *p = *it;
-			if (argc == 1 || p->_itemNum == item)
-				p->dumpInfo();
+		const Std::list<Process *> *lists[] = { &kern->_processes, &kern->_waitQueue };
+		for (int i = 0; i < ARRAYSIZE(lists); ++i) {
+			for (ProcessIter it = lists[i]->begin(); it != lists[i]->end(); ++it) {
+				const Process *p = *it;
+				if (argc == 1 || p->_itemNum == item)
+					p->dumpInfo();
+			}
 		}
 	}
 
@@ -897,6 +906,19 @@ bool Debugger::cmdProcessInfo(int argc, const char **argv) {
 	return true;
 }
 
+bool Debugger::cmdToggleProfile(int argc, const char **argv) {
+	Kernel *kern = Kernel::get_instance();
+	bool profiling = !kern->isProfiling();
+	kern->setProfiling(profiling);
+	debugPrintf("Process profiling = %s\n", strBool(profiling));
+	return true;
+}
+
+bool Debugger::cmdProcessProfile(int argc, const char **argv) {
+	Kernel::get_instance()->processProfile();
+	return true;
+}
+
 bool Debugger::cmdToggleFrameByFrame(int argc, const char **argv) {
 	Kernel *kern = Kernel::get_instance();
 	bool fbf = !kern->isFrameByFrame();
@@ -202,6 +202,7 @@ private:
 	bool cmdStartHighlightItems(int argc, const char **argv);
 	bool cmdStopHighlightItems(int argc, const char **argv);
 	bool cmdToggleHighlightItems(int argc, const char **argv);
+	bool cmdToggleSortStats(int argc, const char **argv);
 	bool cmdDumpMap(int argc, const char **argvv);
 	bool cmdDumpAllMaps(int argc, const char **argv);
 	bool cmdIncrementSortOrder(int argc, const char **argv);
@@ -210,6 +211,8 @@ private:
 	// Kernel
 	bool cmdProcessTypes(int argc, const char **argv);
 	bool cmdListProcesses(int argc, const char **argv);
+	bool cmdToggleProfile(int argc, const char **argv);
+	bool cmdProcessProfile(int argc, const char **argv);
 	bool cmdProcessInfo(int argc, const char **argv);
 	bool cmdToggleFrameByFrame(int argc, const char **argv);
 	bool cmdAdvanceFrame(int argc, const char **argv);
@@ -1602,12 +1602,10 @@ ProcId Actor::dieCru(uint16 damageType, uint16 damagePts, Direction srcDir) {
 
 void Actor::killAllButCombatProcesses() {
 	// loop over all processes, keeping only the relevant ones
-	ProcessIter iter = Kernel::get_instance()->getProcessBeginIterator();
-	ProcessIter endproc = Kernel::get_instance()->getProcessEndIterator();
-	for (; iter != endproc; ++iter) {
+	Std::vector<Process *> procs;
+	Kernel::get_instance()->getProcesses(_objId, procs);
+	for (Std::vector<Process *>::iterator iter = procs.begin(); iter != procs.end(); ++iter) {
 		Process *p = *iter;
-		if (!p) continue;
-		if (p->getItemNum() != _objId) continue;
 		if (p->is_terminated()) continue;
 
 		uint16 type = p->getType();
@@ -1633,12 +1631,11 @@ ProcId Actor::killAllButFallAnims(bool death) {
 	}
 
 	// loop over all animation processes, keeping only the relevant ones
-	ProcessIter iter = Kernel::get_instance()->getProcessBeginIterator();
-	ProcessIter endproc = Kernel::get_instance()->getProcessEndIterator();
-	for (; iter != endproc; ++iter) {
+	Std::vector<Process *> procs;
+	kernel->getProcesses(_objId, procs);
+	for (Std::vector<Process *>::iterator iter = procs.begin(); iter != procs.end(); ++iter) {
 		ActorAnimProcess *p = dynamic_cast<ActorAnimProcess *>(*iter);
 		if (!p) continue;
-		if (p->getItemNum() != _objId) continue;
 		if (p->is_terminated()) continue;
 
 		Animation::Sequence action = p->getAction();
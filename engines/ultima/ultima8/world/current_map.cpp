@@ -79,6 +79,7 @@ void CurrentMap::clear() {
 			for (iter = _items[i][j].begin(); iter != _items[i][j].end(); ++iter)
 				delete *iter;
 			_items[i][j].clear();
+			_boxes[i][j].clear();
 		}
 		memset(_fast[i], false, sizeof(uint32)*MAP_NUM_CHUNKS / 32);
 	}
@@ -147,6 +148,7 @@ void CurrentMap::writeback() {
 				}
 			}
 			_items[i][j].clear();
+			_boxes[i][j].clear();
 		}
 	}
 
@@ -252,6 +254,7 @@ void CurrentMap::addItem(Item *item) {
 #endif
 
 	_items[cx][cy].push_front(item);
+	setItemBoxSlot(item, cx, cy, _boxes[cx][cy].pushFront(item));
 	item->setExtFlag(Item::EXT_INCURMAP);
 
 	Egg *egg = dynamic_cast<Egg *>(item);
@@ -292,6 +295,7 @@ void CurrentMap::addItemToEnd(Item *item) {
 #endif
 
 	_items[cx][cy].push_back(item);
+	setItemBoxSlot(item, cx, cy, _boxes[cx][cy].pushBack(item));
 	item->setExtFlag(Item::EXT_INCURMAP);
 
 	Egg *egg = dynamic_cast<Egg *>(item);
@@ -407,9 +411,167 @@ void CurrentMap::removeItemFromList(Item *item, int32 oldx, int32 oldy) {
 	int32 cy = oldy / _mapChunkSize;
 
 	_items[cx][cy].remove(item);
+	if (item->_boxChunkX == cx && item->_boxChunkY == cy) {
+		ChunkBoxes &boxes = _boxes[cx][cy];
+		const uint idx = item->_boxIndex;
+		if (idx < boxes.end() && boxes._items[idx] == item)
+			boxes.remove(idx);
+	}
 	item->clearExtFlag(Item::EXT_INCURMAP);
 }
 
+void CurrentMap::setItemBoxSlot(Item *item, int32 cx, int32 cy, uint idx) {
+	item->_boxChunkX = cx;
+	item->_boxChunkY = cy;
+	item->_boxIndex = idx;
+}
+
+void CurrentMap::updateItemBox(const Item *item) {
+	// The item stays listed in the same chunk when moved by setLocation
+	ChunkBoxes &boxes = _boxes[item->_boxChunkX][item->_boxChunkY];
+	const uint idx = item->_boxIndex;
+	if (idx < boxes.end() && boxes._items[idx] == item)
+		boxes.update(idx);
+}
+
+CurrentMap::ChunkBoxes::ChunkBoxes() {
+	clear();
+}
+
+uint CurrentMap::ChunkBoxes::pushFront(Item *item) {
+	if (_begin == 0) {
+		// Leave as much room in front as there are items, to keep adding
+		// at the front cheap
+		squeeze(MAX<uint>(16, end() - _holes));
+	}
+
+	_begin--;
+	setBox(_begin, item, 0, 0, 0, 0, 0, 0);
+	update(_begin);
+	return _begin;
+}
+
+uint CurrentMap::ChunkBoxes::pushBack(Item *item) {
+	const uint idx = end();
+	_items.push_back(item);
+	_xMin.push_back(0);
+	_xMax.push_back(0);
+	_yMin.push_back(0);
+	_yMax.push_back(0);
+	_zMin.push_back(0);
+	_zMax.push_back(0);
+	update(idx);
+	return idx;
+}
+
+void CurrentMap::ChunkBoxes::update(uint idx) {
+	int32 ix, iy, iz, ixd, iyd, izd;
+	_items[idx]->getLocation(ix, iy, iz);
+	_items[idx]->getFootpadWorld(ixd, iyd, izd);
+
+	setBox(idx, _items[idx], ix - ixd, ix, iy - iyd, iy, iz, iz + izd);
+	growBounds(idx);
+}
+
+void CurrentMap::ChunkBoxes::remove(uint idx) {
+	// Leave an empty box, which is outside any range
+	setBox(idx, nullptr, INT_MAX_VALUE, -INT_MAX_VALUE, INT_MAX_VALUE, -INT_MAX_VALUE,
+	       INT_MAX_VALUE, -INT_MAX_VALUE);
+	_holes++;
+
+	// Trim holes at either end right away
+	while (_begin < end() && !_items[_begin]) {
+		_begin++;
+		_holes--;
+	}
+	uint newEnd = end();
+	while (newEnd > _begin && !_items[newEnd - 1]) {
+		newEnd--;
+		_holes--;
+	}
+	resize(newEnd);
+
+	if (_holes > 16 && _holes > end() - _begin - _holes)
+		squeeze(_begin);
+}
+
+void CurrentMap::ChunkBoxes::clear() {
+	_items.clear();
+	_xMin.clear();
+	_xMax.clear();
+	_yMin.clear();
+	_yMax.clear();
+	_zMin.clear();
+	_zMax.clear();
+	_begin = 0;
+	_holes = 0;
+	_boundsXMin = _boundsYMin = INT_MAX_VALUE;
+	_boundsXMax = _boundsYMax = -INT_MAX_VALUE;
+}
+
+void CurrentMap::ChunkBoxes::setBox(uint idx, Item *item, int32 xmin, int32 xmax,
+		int32 ymin, int32 ymax, int32 zmin, int32 zmax) {
+	_items[idx] = item;
+	_xMin[idx] = xmin;
+	_xMax[idx] = xmax;
+	_yMin[idx] = ymin;
+	_yMax[idx] = ymax;
+	_zMin[idx] = zmin;
+	_zMax[idx] = zmax;
+}
+
+void CurrentMap::ChunkBoxes::growBounds(uint idx) {
+	_boundsXMin = MIN(_boundsXMin, _xMin[idx]);
+	_boundsXMax = MAX(_boundsXMax, _xMax[idx]);
+	_boundsYMin = MIN(_boundsYMin, _yMin[idx]);
+	_boundsYMax = MAX(_boundsYMax, _yMax[idx]);
+}
+
+void CurrentMap::ChunkBoxes::squeeze(uint headroom) {
+	// Pack the items in use at the start, keeping their order
+	uint count = 0;
+	for (uint i = _begin; i < end(); i++) {
+		if (_items[i]) {
+			moveBox(i, count);
+			count++;
+		}
+	}
+
+	resize(headroom + count);
+	for (uint i = count; i-- > 0;)
+		moveBox(i, headroom + i);
+
+	// The free slots in front have empty boxes, like holes
+	for (uint i = 0; i < headroom; i++)
+		setBox(i, nullptr, INT_MAX_VALUE, -INT_MAX_VALUE, INT_MAX_VALUE, -INT_MAX_VALUE,
+		       INT_MAX_VALUE, -INT_MAX_VALUE);
+
+	_begin = headroom;
+	_holes = 0;
+	_boundsXMin = _boundsYMin = INT_MAX_VALUE;
+	_boundsXMax = _boundsYMax = -INT_MAX_VALUE;
+	for (uint i = _begin; i < end(); i++) {
+		_items[i]->_boxIndex = i;
+		growBounds(i);
+	}
+}
+
+void CurrentMap::ChunkBoxes::moveBox(uint from, uint to) {
+	if (from != to)
+		setBox(to, _items[from], _xMin[from], _xMax[from], _yMin[from], _yMax[from],
+		       _zMin[from], _zMax[from]);
+}
+
+void CurrentMap::ChunkBoxes::resize(uint size) {
+	_items.resize(size);
+	_xMin.resize(size);
+	_xMax.resize(size);
+	_yMin.resize(size);
+	_yMax.resize(size);
+	_zMin.resize(size);
+	_zMax.resize(size);
+}
+
 // Check to see if the chunk is on the screen
 static inline bool ChunkOnScreen(int32 cx, int32 cy, int32 sleft, int32 stop, int32 sright, int32 sbot, int mapChunkSize) {
 	int32 scx = (cx * mapChunkSize - cy * mapChunkSize) / 4;
@@ -584,25 +746,20 @@ void CurrentMap::areaSearch(UCList *itemlist, const uint8 *loopscript,
 	//
 	for (int cy = miny; cy <= maxy; cy++) {
 		for (int cx = minx; cx <= maxx; cx++) {
-			item_list::const_iterator iter;
-			for (iter = _items[cx][cy].begin();
-			        iter != _items[cx][cy].end(); ++iter) {
-
-				const Item *item = *iter;
-
-				if (item->hasExtFlags(Item::EXT_SPRITE))
-					continue;
+			const ChunkBoxes &boxes = _boxes[cx][cy];
+			if (!boxes.inBounds(searchrange.left, searchrange.right, searchrange.top, searchrange.bottom))
+				continue;
 
+			for (uint i = boxes.begin(); i < boxes.end(); i++) {
 				// check if item is in range?
-				int32 ix, iy, iz;
-				item->getLocation(ix, iy, iz);
+				const Rect itemrect(boxes._xMin[i], boxes._yMin[i], boxes._xMax[i], boxes._yMax[i]);
 
-				int32 ixd, iyd, izd;
-				item->getFootpadWorld(ixd, iyd, izd);
+				if (!itemrect.intersects(searchrange))
+					continue;
 
-				const Rect itemrect(ix - ixd, iy - iyd, ix, iy);
+				const Item *item = boxes._items[i];
 
-				if (!itemrect.intersects(searchrange))
+				if (item->hasExtFlags(Item::EXT_SPRITE))
 					continue;
 
 				// check item against loopscript
@@ -649,27 +806,26 @@ void CurrentMap::surfaceSearch(UCList *itemlist, const uint8 *loopscript,
 
 	for (int cy = miny; cy <= maxy; cy++) {
 		for (int cx = minx; cx <= maxx; cx++) {
-			item_list::const_iterator iter;
-			for (iter = _items[cx][cy].begin();
-			        iter != _items[cx][cy].end(); ++iter) {
+			const ChunkBoxes &boxes = _boxes[cx][cy];
+			if (!boxes.inBounds(searchrange.left, searchrange.right, searchrange.top, searchrange.bottom))
+				continue;
 
-				const Item *item = *iter;
+			for (uint i = boxes.begin(); i < boxes.end(); i++) {
+				// check if item is in range?
+				const Rect itemrect(boxes._xMin[i], boxes._yMin[i], boxes._xMax[i], boxes._yMax[i]);
+
+				if (!itemrect.intersects(searchrange))
+					continue;
+
+				const Item *item = boxes._items[i];
 
 				if (item->getObjId() == check)
 					continue;
 				if (item->hasExtFlags(Item::EXT_SPRITE))
 					continue;
 
-				// check if item is in range?
-				int32 ix, iy, iz;
-				item->getLocation(ix, iy, iz);
-				int32 ixd, iyd, izd;
-				item->getFootpadWorld(ixd, iyd, izd);
-
-				const Rect itemrect(ix - ixd, iy - iyd, ix, iy);
-
-				if (!itemrect.intersects(searchrange))
-					continue;
+				int32 iz = boxes._zMin[i];
+				int32 izd = boxes._zMax[i] - boxes._zMin[i];
 
 				bool ok = false;
 
@@ -776,10 +932,17 @@ bool CurrentMap::isValidPosition(int32 x, int32 y, int32 z,
 
 	for (int cx = minx; cx <= maxx; cx++) {
 		for (int cy = miny; cy <= maxy; cy++) {
-			item_list::const_iterator iter;
-			for (iter = _items[cx][cy].begin();
-				 iter != _items[cx][cy].end(); ++iter) {
-				const Item *item = *iter;
+			const ChunkBoxes &boxes = _boxes[cx][cy];
+			if (!boxes.inBounds(x - xd, x, y - yd, y))
+				continue;
+
+			for (uint i = boxes.begin(); i < boxes.end(); i++) {
+				// Items not overlapping in xy can't block, support or roof
+				if (x <= boxes._xMin[i] || x - xd >= boxes._xMax[i] ||
+				        y <= boxes._yMin[i] || y - yd >= boxes._yMax[i])
+					continue;
+
+				const Item *item = boxes._items[i];
 				if (item->getObjId() == item_)
 					continue;
 				if (item->hasExtFlags(Item::EXT_SPRITE))
@@ -790,9 +953,12 @@ bool CurrentMap::isValidPosition(int32 x, int32 y, int32 z,
 				if (!(si->_flags & flagmask))
 					continue; // not an interesting item
 
-				int32 ix, iy, iz, ixd, iyd, izd;
-				item->getFootpadWorld(ixd, iyd, izd);
-				item->getLocation(ix, iy, iz);
+				int32 ix = boxes._xMax[i];
+				int32 iy = boxes._yMax[i];
+				int32 iz = boxes._zMin[i];
+				int32 ixd = ix - boxes._xMin[i];
+				int32 iyd = iy - boxes._yMin[i];
+				int32 izd = boxes._zMax[i] - iz;
 
 #if 0
 				if (item->getShape() == 145) {
@@ -900,9 +1066,11 @@ bool CurrentMap::scanForValidPosition(int32 x, int32 y, int32 z, const Item *ite
 
 	for (int cx = minx; cx <= maxx; cx++) {
 		for (int cy = miny; cy <= maxy; cy++) {
-			for (item_list::const_iterator iter = _items[cx][cy].begin();
-			        iter != _items[cx][cy].end(); ++iter) {
-				const Item *citem = *iter;
+			const ChunkBoxes &boxes = _boxes[cx][cy];
+			for (uint n = boxes.begin(); n < boxes.end(); n++) {
+				const Item *citem = boxes._items[n];
+				if (!citem)
+					continue;
 				if (citem->getObjId() == item->getObjId())
 					continue;
 				if (citem->hasExtFlags(Item::EXT_SPRITE))
@@ -913,9 +1081,12 @@ bool CurrentMap::scanForValidPosition(int32 x, int32 y, int32 z, const Item *ite
 				if (!(si->_flags & blockflagmask))
 					continue; // not an interesting item
 
-				int32 ix, iy, iz, ixd, iyd, izd;
-				citem->getLocation(ix, iy, iz);
-				citem->getFootpadWorld(ixd, iyd, izd);
+				int32 ix = boxes._xMax[n];
+				int32 iy = boxes._yMax[n];
+				int32 iz = boxes._zMin[n];
+				int32 ixd = ix - boxes._xMin[n];
+				int32 iyd = iy - boxes._yMin[n];
+				int32 izd = boxes._zMax[n] - iz;
 
 				int minv = iz - z - zd + 1;
 				int maxv = iz + izd - z - 1;
@@ -1073,15 +1244,30 @@ bool CurrentMap::sweepTest(const int32 start[3], const int32 end[3],
 //	pout << "Sweeping to   (" << vel[0]-ext[0] << ", " << vel[1]-ext[1] << ", " << vel[2]-ext[2] << ")" << Std::endl;
 //	pout << "              (" << vel[0]+ext[0] << ", " << vel[1]+ext[1] << ", " << vel[2]+ext[2] << ")" << Std::endl;
 
+	// The box covering the whole move. Items not touching it can't be hit.
+	const int32 sweepXMin = MIN(start[0], end[0]) - dims[0];
+	const int32 sweepXMax = MAX(start[0], end[0]);
+	const int32 sweepYMin = MIN(start[1], end[1]) - dims[1];
+	const int32 sweepYMax = MAX(start[1], end[1]);
+	const int32 sweepZMin = MIN(start[2], end[2]);
+	const int32 sweepZMax = MAX(start[2], end[2]) + dims[2];
+
 	Std::list<SweepItem>::iterator sw_it;
 	if (hit) sw_it = hit->end();
 
 	for (int cx = minx; cx <= maxx; cx++) {
 		for (int cy = miny; cy <= maxy; cy++) {
-			item_list::const_iterator iter;
-			for (iter = _items[cx][cy].begin();
-			        iter != _items[cx][cy].end(); ++iter) {
-				const Item *other_item = *iter;
+			const ChunkBoxes &boxes = _boxes[cx][cy];
+			if (!boxes.inBounds(sweepXMin, sweepXMax, sweepYMin, sweepYMax))
+				continue;
+
+			for (uint n = boxes.begin(); n < boxes.end(); n++) {
+				if (boxes._xMax[n] < sweepXMin || boxes._xMin[n] > sweepXMax ||
+				        boxes._yMax[n] < sweepYMin || boxes._yMin[n] > sweepYMax ||
+				        boxes._zMax[n] < sweepZMin || boxes._zMin[n] > sweepZMax)
+					continue;
+
+				const Item *other_item = boxes._items[n];
 				if (other_item->getObjId() == item)
 					continue;
 				if (other_item->hasExtFlags(Item::EXT_SPRITE))
@@ -1268,10 +1454,19 @@ const Item *CurrentMap::traceTopItem(int32 x, int32 y, int32 ztop, int32 zbot, O
 
 	for (int cx = minx; cx <= maxx; cx++) {
 		for (int cy = miny; cy <= maxy; cy++) {
-			item_list::const_iterator iter;
-			for (iter = _items[cx][cy].begin();
-			        iter != _items[cx][cy].end(); ++iter) {
-				const Item *item = *iter;
+			const ChunkBoxes &boxes = _boxes[cx][cy];
+			if (!boxes.inBounds(x, x, y, y))
+				continue;
+
+			for (uint i = boxes.begin(); i < boxes.end(); i++) {
+				if (boxes._xMin[i] >= x || boxes._xMax[i] <= x)
+					continue;
+				if (boxes._yMin[i] >= y || boxes._yMax[i] <= y)
+					continue;
+				if (boxes._zMin[i] >= ztop || boxes._zMax[i] <= zbot)
+					continue;
+
+				const Item *item = boxes._items[i];
 				if (item->getObjId() == ignore)
 					continue;
 				if (item->hasExtFlags(Item::EXT_SPRITE))
@@ -1280,16 +1475,8 @@ const Item *CurrentMap::traceTopItem(int32 x, int32 y, int32 ztop, int32 zbot, O
 				const ShapeInfo *si = item->getShapeInfo();
 				if (!(si->_flags & shflags) || si->is_editor() || si->is_translucent()) continue;
 
-				int32 ix, iy, iz, ixd, iyd, izd;
-				item->getLocation(ix, iy, iz);
-				item->getFootpadWorld(ixd, iyd, izd);
-
-				if ((ix - ixd) >= x || ix <= x)
-					continue;
-				if ((iy - iyd) >= y || iy <= y)
-					continue;
-				if (iz >= ztop || (iz + izd) <= zbot)
-					continue;
+				int32 iz = boxes._zMin[i];
+				int32 izd = boxes._zMax[i] - iz;
 
 				if (top) {
 					int32 tix, tiy, tiz, tixd, tiyd, tizd;
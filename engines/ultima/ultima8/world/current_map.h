@@ -70,6 +70,10 @@ public:
 	void removeItemFromList(Item *item, int32 oldx, int32 oldy);
 	void removeItem(Item *item);
 
+	//! Update the stored bounding box of an item after it moved, changed
+	//! shape or was flipped without changing chunks
+	void updateItemBox(const Item *item);
+
 	//! Add an item to the list of possible targets (in Crusader)
 	void addTargetItem(const Item *item);
 	//! Remove an item from the list of possible targets (in Crusader)
@@ -216,6 +220,68 @@ public:
 	INTRINSIC(I_canExistAtPoint);
 
 private:
+	/**
+	 * World space bounding boxes of the items in one chunk, kept in the same
+	 * order as the chunk's item list. Searches test these packed arrays and
+	 * only look at the items whose box is in range.
+	 *
+	 * Each item remembers its slot, so boxes are updated without a search.
+	 * The slots in use are [begin(), end()), with free room kept in front
+	 * for items added at the start of the list. Removed items leave a hole
+	 * with a null item and an empty box, which no range test accepts. Holes
+	 * are squeezed out once there are too many of them.
+	 *
+	 * The bounds cover every box in the chunk, but are only recalculated
+	 * when the arrays are squeezed, so they may be larger than needed.
+	 */
+	struct ChunkBoxes {
+		Common::Array<Item *> _items;
+		Common::Array<int32> _xMin, _xMax;
+		Common::Array<int32> _yMin, _yMax;
+		Common::Array<int32> _zMin, _zMax;
+		int32 _boundsXMin, _boundsXMax;
+		int32 _boundsYMin, _boundsYMax;
+
+		ChunkBoxes();
+
+		uint begin() const {
+			return _begin;
+		}
+
+		uint end() const {
+			return _items.size();
+		}
+
+		//! Do the bounds touch or overlap the given xy range?
+		bool inBounds(int32 xmin, int32 xmax, int32 ymin, int32 ymax) const {
+			return xmin <= _boundsXMax && _boundsXMin <= xmax &&
+			       ymin <= _boundsYMax && _boundsYMin <= ymax;
+		}
+
+		//! Add an item before all others, and return its slot
+		uint pushFront(Item *item);
+		//! Add an item after all others, and return its slot
+		uint pushBack(Item *item);
+		void update(uint idx);
+		void remove(uint idx);
+		void clear();
+
+	private:
+		uint _begin; // first slot in use
+		uint _holes; // removed slots in [_begin, end())
+
+		void setBox(uint idx, Item *item, int32 xmin, int32 xmax, int32 ymin, int32 ymax,
+		            int32 zmin, int32 zmax);
+		void moveBox(uint from, uint to);
+		void resize(uint size);
+		void growBounds(uint idx);
+		//! Move the items in use to start after the given number of free slots
+		void squeeze(uint headroom);
+	};
+
+	//! Remember where the boxes keep the item
+	void setItemBoxSlot(Item *item, int32 cx, int32 cy, uint idx);
+
 	void loadItems(const Std::list<Item *> &itemlist, bool callCacheIn);
 	void createEggHatcher();
 
@@ -227,6 +293,7 @@ private:
 	// item lists. Lots of them :-)
 	// items[x][y]
 	Std::list<Item *> _items[MAP_NUM_CHUNKS][MAP_NUM_CHUNKS];
+	ChunkBoxes _boxes[MAP_NUM_CHUNKS][MAP_NUM_CHUNKS];
 
 	ProcId _eggHatcher;
 
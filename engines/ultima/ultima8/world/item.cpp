@@ -77,7 +77,8 @@ Item::Item()
 	  _extendedFlags(0), _parent(0),
 	  _cachedShape(nullptr), _cachedShapeInfo(nullptr),
 	  _gump(0), _gravityPid(0), _lastSetup(0),
-	  _ix(0), _iy(0), _iz(0), _damagePoints(1) {
+	  _ix(0), _iy(0), _iz(0), _damagePoints(1),
+	  _boxChunkX(0), _boxChunkY(0), _boxIndex(0) {
 }
 
 
@@ -149,6 +150,16 @@ void Item::setLocation(int32 X, int32 Y, int32 Z) {
 	_x = X;
 	_y = Y;
 	_z = Z;
+	boxChanged();
+}
+
+void Item::boxChanged() {
+	if (!(_extendedFlags & EXT_INCURMAP))
+		return;
+
+	World *world = World::get_instance();
+	if (world && world->getCurrentMap())
+		world->getCurrentMap()->updateItemBox(this);
 }
 
 void Item::move(const Point3 &pt) {
@@ -217,6 +228,9 @@ void Item::move(int32 X, int32 Y, int32 Z) {
 			map->addItemToEnd(this);
 		else
 			map->addItem(this);
+	} else {
+		// Still in the same chunk
+		map->updateItemBox(this);
 	}
 
 	// Call just moved
@@ -493,6 +507,8 @@ void Item::setShape(uint32 shape) {
 		_shape = shape;
 		_cachedShapeInfo = nullptr;
 	}
+
+	boxChanged();
 }
 
 bool Item::overlaps(const Item &item2) const {
@@ -2977,7 +2993,8 @@ uint32 Item::I_andStatus(const uint8 *args, unsigned int argsize) {
 	ARG_UINT16(mask);
 	if (!item) return 0;
 
-	item->_flags &= mask;
+	// Through clearFlag, so a change of FLG_FLIPPED updates the map
+	item->clearFlag(~mask & 0xFFFF);
 	return 0;
 }
 
@@ -41,6 +41,7 @@ class GravityProcess;
 
 class Item : public Object {
 	friend class ItemFactory;
+	friend class CurrentMap;
 
 public:
 	Item();
@@ -66,7 +67,7 @@ public:
 	Item *getTopItem();
 
 	//! Set item location. This strictly sets the location, and does not
-	//! even update CurrentMap
+	//! move the item to another CurrentMap chunk
 	void setLocation(int32 x, int32 y, int32 z); // this only sets the loc.
 
 	//! Move an item. This moves an item to the new location, and updates
@@ -150,6 +151,8 @@ public:
 	//! Set the flags set in the given mask.
 	void setFlag(uint32 mask) {
 		_flags |= mask;
+		if (mask & FLG_FLIPPED)
+			boxChanged();
 	}
 
 	virtual void setFlagRecursively(uint32 mask) {
@@ -159,6 +162,8 @@ public:
 	//! Clear the flags set in the given mask.
 	void clearFlag(uint32 mask) {
 		_flags &= ~mask;
+		if (mask & FLG_FLIPPED)
+			boxChanged();
 	}
 
 	//! Set _extendedFlags
@@ -655,9 +660,16 @@ private:
 	//! The gametick setupLerp was last called on
 	int32 _lastSetup;
 
+	//! Where CurrentMap keeps the bounding box, while EXT_INCURMAP is set
+	int16 _boxChunkX, _boxChunkY;
+	uint32 _boxIndex;
+
 	//! Animate the item (called by setupLerp)
 	void animateItem();
 
+	//! Let CurrentMap know the bounding box changed, if the item is in it
+	void boxChanged();
+
 	//! The U8 version of receiveHit
 	void receiveHitU8(ObjId other, Direction dir, int damage, uint16 type);
 
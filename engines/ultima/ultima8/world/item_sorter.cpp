@@ -29,6 +29,8 @@
 #include "ultima/ultima8/misc/rect.h"
 #include "ultima/ultima8/games/game_data.h"
 #include "ultima/ultima8/ultima8.h"
+#include "common/algorithm.h"
+#include "common/system.h"
 
 // temp
 #include "ultima/ultima8/world/actors/weapon_overlay.h"
@@ -41,19 +43,22 @@
 namespace Ultima {
 namespace Ultima8 {
 
+// Size of the screen-space bins used to find overlapping items
+static const int32 SORT_BIN_SIZE = 64;
+
 ItemSorter::ItemSorter() :
 	_shapes(nullptr), _surf(nullptr), _items(nullptr), _itemsTail(nullptr),
-	_itemsUnused(nullptr), _sortLimit(0), _camSx(0), _camSy(0), _orderCounter(0) {
+	_itemsUnused(nullptr), _sortLimit(0), _camSx(0), _camSy(0), _orderCounter(0),
+	_sorted(true), _prevSorted(false), _binLeft(0), _binTop(0), _binCols(0), _binRows(0) {
 	int i = 2048;
 	while (i--) _itemsUnused = new SortItem(_itemsUnused);
+
+	memset(&_stats, 0, sizeof(_stats));
 }
 
 ItemSorter::~ItemSorter() {
-	//
-	if (_itemsTail) {
-		_itemsTail->_next = _itemsUnused;
-		_itemsUnused = _items;
-	}
+	RecycleItems(_added);
+	RecycleItems(_prevAdded);
 	_items = nullptr;
 	_itemsTail = nullptr;
 
@@ -62,8 +67,14 @@ ItemSorter::~ItemSorter() {
 		delete _itemsUnused;
 		_itemsUnused = _next;
 	}
+}
 
-	delete [] _items;
+void ItemSorter::RecycleItems(Common::Array<SortItem *> &items) {
+	for (uint i = 0; i < items.size(); i++) {
+		items[i]->_next = _itemsUnused;
+		_itemsUnused = items[i];
+	}
+	items.clear();
 }
 
 void ItemSorter::BeginDisplayList(RenderSurface *rs,
@@ -71,13 +82,14 @@ void ItemSorter::BeginDisplayList(RenderSurface *rs,
 	// Get the _shapes, if required
 	if (!_shapes) _shapes = GameData::get_instance()->getMainShapes();
 
-	//
-	if (_itemsTail) {
-		_itemsTail->_next = _itemsUnused;
-		_itemsUnused = _items;
-	}
+	// Keep the last frame's items around, they may be reused
+	RecycleItems(_prevAdded);
+	_prevAdded = _added;
+	_added.clear();
 	_items = nullptr;
 	_itemsTail = nullptr;
+	_prevSorted = _sorted;
+	_sorted = false;
 
 	// Set the RenderSurface, and reset the item list
 	_surf = rs;
@@ -178,17 +190,178 @@ void ItemSorter::AddItem(int32 x, int32 y, int32 z, uint32 shapeNum, uint32 fram
 	// are never deleted
 	si->_depends.clear();
 
-	// Iterate the list and compare _shapes
+	// The dependencies are worked out once all items are in
+	_itemsUnused = _itemsUnused->_next;
+	_added.push_back(si);
+}
+
+void ItemSorter::AddItem(const Item *add) {
+	int32 x, y, z;
+	add->getLerped(x, y, z);
+	AddItem(x, y, z, add->getShape(), add->getFrame(),
+			add->getFlags(), add->getExtFlags(), add->getObjId());
+}
+
+/**
+ * Work out the painting dependencies of all added items and put them
+ * into the painting list, if that wasn't done yet.
+ */
+void ItemSorter::SortDisplayList() {
+	if (_sorted)
+		return;
+	_sorted = true;
+
+	uint32 start = g_system->getMillis();
+
+	_stats._items = _added.size();
+	_stats._tests = 0;
+	_stats._bruteTests = _added.size() * (_added.size() - 1) / 2;
+	_stats._reused = ReuseDependencies();
+	if (!_stats._reused)
+		BuildDependencies();
+
+	LinkDisplayList();
+
+	_stats._time = g_system->getMillis() - start;
+}
+
+/**
+ * If the same items were added as in the last frame, keep the last frame's
+ * items and dependencies, only taking over the new screen coordinates.
+ * Screen coordinates of two items differ by the same amount for any camera
+ * position, so the dependencies still hold.
+ */
+bool ItemSorter::ReuseDependencies() {
+	if (!_prevSorted || _added.empty() || _added.size() != _prevAdded.size())
+		return false;
+
+	for (uint i = 0; i < _added.size(); i++) {
+		const SortItem *si = _added[i];
+		const SortItem *prev = _prevAdded[i];
+		if (si->_x != prev->_x || si->_y != prev->_y || si->_z != prev->_z ||
+				si->_shapeNum != prev->_shapeNum || si->_frame != prev->_frame ||
+				si->_flags != prev->_flags || si->_extFlags != prev->_extFlags ||
+				si->_itemNum != prev->_itemNum)
+			return false;
+	}
+
+	for (uint i = 0; i < _added.size(); i++) {
+		const SortItem *si = _added[i];
+		SortItem *prev = _prevAdded[i];
+		prev->_sx = si->_sx;
+		prev->_sy = si->_sy;
+		prev->_sx2 = si->_sx2;
+		prev->_sy2 = si->_sy2;
+		prev->_sxLeft = si->_sxLeft;
+		prev->_sxRight = si->_sxRight;
+		prev->_sxTop = si->_sxTop;
+		prev->_syTop = si->_syTop;
+		prev->_sxBot = si->_sxBot;
+		prev->_syBot = si->_syBot;
+		prev->_clipped = si->_clipped;
+		prev->_order = -1;
+	}
+
+	// Swap, so the new items are the ones given back
+	Common::Array<SortItem *> tmp = _added;
+	_added = _prevAdded;
+	_prevAdded = tmp;
+	return true;
+}
+
+void ItemSorter::GetBins(const SortItem *si, int32 &x1, int32 &y1, int32 &x2, int32 &y2) const {
+	x1 = CLIP<int32>((si->_sxLeft - _binLeft) / SORT_BIN_SIZE, 0, _binCols - 1);
+	x2 = CLIP<int32>((si->_sxRight - _binLeft) / SORT_BIN_SIZE, 0, _binCols - 1);
+	y1 = CLIP<int32>((si->_syTop - _binTop) / SORT_BIN_SIZE, 0, _binRows - 1);
+	y2 = CLIP<int32>((si->_syBot - _binTop) / SORT_BIN_SIZE, 0, _binRows - 1);
+}
+
+void ItemSorter::BuildDependencies() {
+	// Items only overlap if their screenspace bounding boxes do, so it's
+	// enough to compare items sharing a bin. Anything beyond the clipping
+	// rect ends up in the border bins.
+	Rect clip;
+	_surf->GetClippingRect(clip);
+	_binLeft = clip.left;
+	_binTop = clip.top;
+	_binCols = MAX<int32>(1, (clip.right - clip.left + SORT_BIN_SIZE - 1) / SORT_BIN_SIZE);
+	_binRows = MAX<int32>(1, (clip.bottom - clip.top + SORT_BIN_SIZE - 1) / SORT_BIN_SIZE);
+	_binHeads.resize(_binCols * _binRows);
+	for (uint i = 0; i < _binHeads.size(); i++)
+		_binHeads[i] = -1;
+	_binEntries.clear();
+
+	for (uint i = 0; i < _added.size(); i++) {
+		AddDependencies(i);
+
+		int32 x1, y1, x2, y2;
+		GetBins(_added[i], x1, y1, x2, y2);
+		for (int32 by = y1; by <= y2; by++) {
+			for (int32 bx = x1; bx <= x2; bx++) {
+				BinEntry entry;
+				entry._index = i;
+				entry._next = _binHeads[by * _binCols + bx];
+				_binHeads[by * _binCols + bx] = _binEntries.size();
+				_binEntries.push_back(entry);
+			}
+		}
+	}
+}
+
+namespace {
+
+// Painting list order: by z, flats first, then in the order added
+struct ListOrder {
+	const Common::Array<SortItem *> &_items;
+
+	ListOrder(const Common::Array<SortItem *> &items) : _items(items) {}
+
+	bool operator()(int32 a, int32 b) const {
+		if (_items[a]->ListLessThan(_items[b]))
+			return true;
+		if (_items[b]->ListLessThan(_items[a]))
+			return false;
+		return a < b;
+	}
+};
+
+} // End of anonymous namespace
+
+/**
+ * Compare an item against the items added before it. The items are visited
+ * in painting list order, so the result is the same as comparing against
+ * the whole list.
+ */
+void ItemSorter::AddDependencies(int32 index) {
+	SortItem *si = _added[index];
+
+	_candidates.clear();
+	int32 x1, y1, x2, y2;
+	GetBins(si, x1, y1, x2, y2);
+	for (int32 by = y1; by <= y2; by++) {
+		for (int32 bx = x1; bx <= x2; bx++) {
+			for (int32 e = _binHeads[by * _binCols + bx]; e >= 0; e = _binEntries[e]._next)
+				_candidates.push_back(_binEntries[e]._index);
+		}
+	}
+
+	if (_candidates.empty())
+		return;
+
+	Common::sort(_candidates.begin(), _candidates.end(), ListOrder(_added));
+
+	for (uint i = 0; i < _candidates.size(); i++) {
+		// Items spanning several bins are found more than once
+		if (i > 0 && _candidates[i] == _candidates[i - 1])
+			continue;
 
-	// Ok,
-	SortItem *addpoint = nullptr;
-	for (SortItem *si2 = _items; si2 != nullptr; si2 = si2->_next) {
-		// Get the insert point... which is before the first item that has higher z than us
-		if (!addpoint && si->ListLessThan(si2))
-			addpoint = si2;
+		SortItem *si2 = _added[_candidates[i]];
 
 		// Doesn't overlap
-		if (si2->_occluded || !si->overlap(*si2))
+		if (si2->_occluded)
+			continue;
+		_stats._tests++;
+		if (!si->overlap(*si2))
 			continue;
 
 		// Attempt to find which is infront
@@ -211,43 +384,34 @@ void ItemSorter::AddItem(int32 x, int32 y, int32 z, uint32 shapeNum, uint32 fram
 				si->_depends.push_back(si2);
 		}
 	}
+}
 
-	// Add it to the list
-	_itemsUnused = _itemsUnused->_next;
+void ItemSorter::LinkDisplayList() {
+	Common::Array<int32> order;
+	order.resize(_added.size());
+	for (uint i = 0; i < _added.size(); i++)
+		order[i] = i;
+	Common::sort(order.begin(), order.end(), ListOrder(_added));
 
-	// have a position
-	//addpoint = 0;
-	if (addpoint) {
-		si->_next = addpoint;
-		si->_prev = addpoint->_prev;
-		addpoint->_prev = si;
-		if (si->_prev)
-			si->_prev->_next = si;
-		else
-			_items = si;
-	}
-	// Add it to the end of the list
-	else {
+	_items = nullptr;
+	_itemsTail = nullptr;
+	for (uint i = 0; i < order.size(); i++) {
+		SortItem *si = _added[order[i]];
+		si->_prev = _itemsTail;
+		si->_next = nullptr;
 		if (_itemsTail)
 			_itemsTail->_next = si;
-		if (!_items)
+		else
 			_items = si;
-		si->_next = nullptr;
-		si->_prev = _itemsTail;
 		_itemsTail = si;
 	}
 }
 
-void ItemSorter::AddItem(const Item *add) {
-	int32 x, y, z;
-	add->getLerped(x, y, z);
-	AddItem(x, y, z, add->getShape(), add->getFrame(),
-			add->getFlags(), add->getExtFlags(), add->getObjId());
-}
-
 SortItem *_prev = 0;
 
 void ItemSorter::PaintDisplayList(bool item_highlight) {
+	SortDisplayList();
+
 	_prev = nullptr;
 	SortItem *it = _items;
 	SortItem *end = nullptr;
@@ -393,6 +557,8 @@ uint16 ItemSorter::Trace(int32 x, int32 y, HitFace *face, bool item_highlight) {
 	SortItem *it;
 	SortItem *selected;
 
+	SortDisplayList();
+
 	if (!_orderCounter) { // If no _orderCounter we need to sort the _items
 		it = _items;
 		_orderCounter = 0;  // Reset the _orderCounter
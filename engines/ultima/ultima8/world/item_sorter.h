@@ -22,6 +22,8 @@
 #ifndef ULTIMA8_WORLD_ITEMSORTER_H
 #define ULTIMA8_WORLD_ITEMSORTER_H
 
+#include "common/array.h"
+
 namespace Ultima {
 namespace Ultima8 {
 
@@ -30,7 +32,31 @@ class Item;
 class RenderSurface;
 struct SortItem;
 
+/**
+ * Sorts the visible items into painting order and paints them.
+ *
+ * Items are only compared against the items sharing a screen-space bin
+ * with them. The dependencies between items do not depend on the camera,
+ * so if exactly the same items are added as in the previous frame, the
+ * previous frame's dependencies are kept and only the screen coordinates
+ * are updated.
+ */
 class ItemSorter {
+public:
+	struct SortStats {
+		uint32  _items;         // Items added in the last frame
+		uint32  _tests;         // Overlap tests done in the last frame
+		uint32  _bruteTests;    // Overlap tests comparing every pair would do
+		bool    _reused;        // Last frame's order was reused
+		uint32  _time;          // Time spent sorting in ms
+	};
+
+private:
+	struct BinEntry {
+		int32   _index;         // Index in _added
+		int32   _next;          // Next entry in the same bin, or -1
+	};
+
 	MainShapeArchive    *_shapes;
 	RenderSurface   *_surf;
 
@@ -43,6 +69,19 @@ class ItemSorter {
 
 	int32       _camSx, _camSy;
 
+	Common::Array<SortItem *> _added;       // This frame's items, in the order they were added
+	Common::Array<SortItem *> _prevAdded;   // Last frame's items
+	bool        _sorted;
+	bool        _prevSorted;
+
+	int32       _binLeft, _binTop;
+	int32       _binCols, _binRows;
+	Common::Array<int32> _binHeads;
+	Common::Array<BinEntry> _binEntries;
+	Common::Array<int32> _candidates;
+
+	SortStats   _stats;
+
 public:
 	ItemSorter();
 	~ItemSorter();
@@ -66,7 +105,19 @@ public:
 
 	void IncSortLimit(int count);
 
+	const SortStats &getStats() const {
+		return _stats;
+	}
+
 private:
+	void SortDisplayList();
+	bool ReuseDependencies();
+	void BuildDependencies();
+	void AddDependencies(int32 index);
+	void LinkDisplayList();
+	void GetBins(const SortItem *si, int32 &x1, int32 &y1, int32 &x2, int32 &y2) const;
+	void RecycleItems(Common::Array<SortItem *> &items);
+
 	bool PaintSortItem(SortItem *);
 	bool NullPaintSortItem(SortItem *);
 };
@@ -32,6 +32,7 @@
 #include "engines/wintermute/base/base_engine.h"
 #include "engines/wintermute/base/base_file_manager.h"
 #include "engines/wintermute/platform_osystem.h"
+#include "common/config-manager.h"
 #include "common/str.h"
 
 namespace Wintermute {
@@ -41,6 +42,15 @@ namespace Wintermute {
 //////////////////////////////////////////////////////////////////////
 BaseSurfaceStorage::BaseSurfaceStorage(BaseGame *inGame) : BaseClass(inGame) {
 	_lastCleanupTime = 0;
+
+	_peakBytes = 0;
+	_hits = _misses = _evictions = 0;
+
+	int budget = SURFACE_CACHE_BUDGET;
+	if (ConfMan.hasKey("surface_cache_budget")) {
+		budget = ConfMan.getInt("surface_cache_budget");
+	}
+	setBudget(budget);
 }
 
 
@@ -52,11 +62,11 @@ BaseSurfaceStorage::~BaseSurfaceStorage() {
 
 //////////////////////////////////////////////////////////////////////////
 bool BaseSurfaceStorage::cleanup(bool warn) {
-	for (uint32 i = 0; i < _surfaces.size(); i++) {
+	for (SurfaceMap::iterator it = _surfaces.begin(); it != _surfaces.end(); ++it) {
 		if (warn) {
-			BaseEngine::LOG(0, "BaseSurfaceStorage warning: purging surface '%s', usage:%d", _surfaces[i]->getFileName(), _surfaces[i]->_referenceCount);
+			BaseEngine::LOG(0, "BaseSurfaceStorage warning: purging surface '%s', usage:%d", it->_value->getFileName(), it->_value->_referenceCount);
 		}
-		delete _surfaces[i];
+		delete it->_value;
 	}
 	_surfaces.clear();
 
@@ -66,34 +76,82 @@ bool BaseSurfaceStorage::cleanup(bool warn) {
 
 //////////////////////////////////////////////////////////////////////////
 bool BaseSurfaceStorage::initLoop() {
-	if (_gameRef->_smartCache && _gameRef->getLiveTimer()->getTime() - _lastCleanupTime >= _gameRef->_surfaceGCCycleTime) {
-		_lastCleanupTime = _gameRef->getLiveTimer()->getTime();
-		sortSurfaces();
-		for (uint32 i = 0; i < _surfaces.size(); i++) {
-			if (_surfaces[i]->_lifeTime <= 0) {
+	uint32 now = _gameRef->getLiveTimer()->getTime();
+	uint32 elapsed = now - _lastCleanupTime;
+
+	bool expire = _gameRef->_smartCache && elapsed >= _gameRef->_surfaceGCCycleTime;
+	if (expire || (_budget && elapsed >= SURFACE_MIN_IDLE_TIME)) {
+		_lastCleanupTime = now;
+		evictSurfaces(now, expire);
+	}
+	return STATUS_OK;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+void BaseSurfaceStorage::evictSurfaces(uint32 now, bool expire) {
+	Common::Array<BaseSurface *> loaded;
+	uint32 loadedBytes = 0;
+
+	for (SurfaceMap::iterator it = _surfaces.begin(); it != _surfaces.end(); ++it) {
+		BaseSurface *surface = it->_value;
+		uint32 size = surface->getLoadedSize();
+		if (!size) {
+			continue;
+		}
+
+		// Pinned and generated surfaces can't be reloaded from disk, they only count towards the total
+		if (surface->isKeepLoaded() || surface->getFileNameStr().empty()) {
+			loadedBytes += size;
+			continue;
+		}
+
+		if (expire && surface->_lifeTime > 0 && (int)(now - surface->_lastUsedTime) >= surface->_lifeTime && surface->invalidate()) {
+			_evictions++;
+			continue;
+		}
+
+		loadedBytes += size;
+		loaded.push_back(surface);
+	}
+	_peakBytes = MAX(_peakBytes, loadedBytes);
+
+	if (_budget && loadedBytes > _budget) {
+		Common::sort(loaded.begin(), loaded.end(), surfaceSortCB);
+		for (uint32 i = 0; i < loaded.size() && loadedBytes > _budget; i++) {
+			BaseSurface *surface = loaded[i];
+			// Everything from here on is still in use, evicting it would only thrash
+			if (surface->_lastUsedTime > now || now - surface->_lastUsedTime < SURFACE_MIN_IDLE_TIME) {
 				break;
 			}
 
-			if (_surfaces[i]->_lifeTime > 0 && _surfaces[i]->_valid && (int)(_gameRef->getLiveTimer()->getTime() - _surfaces[i]->_lastUsedTime) >= _surfaces[i]->_lifeTime) {
-				//_gameRef->QuickMessageForm("Invalidating: %s", _surfaces[i]->_filename);
-				_surfaces[i]->invalidate();
+			uint32 size = surface->getLoadedSize();
+			if (surface->invalidate()) {
+				loadedBytes -= size;
+				_evictions++;
 			}
 		}
 	}
-	return STATUS_OK;
 }
 
 
 //////////////////////////////////////////////////////////////////////
 bool BaseSurfaceStorage::removeSurface(BaseSurface *surface) {
-	for (uint32 i = 0; i < _surfaces.size(); i++) {
-		if (_surfaces[i] == surface) {
-			_surfaces[i]->_referenceCount--;
-			if (_surfaces[i]->_referenceCount <= 0) {
-				delete _surfaces[i];
-				_surfaces.remove_at(i);
+	SurfaceMap::iterator it = _surfaces.find(surface->getFileNameStr());
+	if (it == _surfaces.end() || it->_value != surface) {
+		// Not registered under its own name, fall back to looking for the pointer
+		for (it = _surfaces.begin(); it != _surfaces.end(); ++it) {
+			if (it->_value == surface) {
+				break;
 			}
-			break;
+		}
+	}
+
+	if (it != _surfaces.end()) {
+		surface->_referenceCount--;
+		if (surface->_referenceCount <= 0) {
+			_surfaces.erase(it);
+			delete surface;
 		}
 	}
 	return STATUS_OK;
@@ -102,11 +160,11 @@ bool BaseSurfaceStorage::removeSurface(BaseSurface *surface) {
 
 //////////////////////////////////////////////////////////////////////
 BaseSurface *BaseSurfaceStorage::addSurface(const Common::String &filename, bool defaultCK, byte ckRed, byte ckGreen, byte ckBlue, int lifeTime, bool keepLoaded) {
-	for (uint32 i = 0; i < _surfaces.size(); i++) {
-		if (scumm_stricmp(_surfaces[i]->getFileName(), filename.c_str()) == 0) {
-			_surfaces[i]->_referenceCount++;
-			return _surfaces[i];
-		}
+	SurfaceMap::iterator it = _surfaces.find(filename);
+	if (it != _surfaces.end()) {
+		_hits++;
+		it->_value->_referenceCount++;
+		return it->_value;
 	}
 
 	if (!BaseFileManager::getEngineInstance()->hasFile(filename)) {
@@ -120,6 +178,8 @@ BaseSurface *BaseSurfaceStorage::addSurface(const Common::String &filename, bool
 		}
 	}
 
+	_misses++;
+
 	BaseSurface *surface;
 	surface = BaseEngine::getRenderer()->createSurface();
 
@@ -132,7 +192,7 @@ BaseSurface *BaseSurfaceStorage::addSurface(const Common::String &filename, bool
 		return nullptr;
 	} else {
 		surface->_referenceCount = 1;
-		_surfaces.push_back(surface);
+		_surfaces[filename] = surface;
 		return surface;
 	}
 }
@@ -141,8 +201,8 @@ BaseSurface *BaseSurfaceStorage::addSurface(const Common::String &filename, bool
 //////////////////////////////////////////////////////////////////////
 bool BaseSurfaceStorage::restoreAll() {
 	bool ret;
-	for (uint32 i = 0; i < _surfaces.size(); i++) {
-		ret = _surfaces[i]->restore();
+	for (SurfaceMap::iterator it = _surfaces.begin(); it != _surfaces.end(); ++it) {
+		ret = it->_value->restore();
 		if (ret != STATUS_OK) {
 			BaseEngine::LOG(0, "BaseSurfaceStorage::RestoreAll failed");
 			return ret;
@@ -169,37 +229,36 @@ bool BaseSurfaceStorage::persist(BasePersistenceManager *persistMgr)
 
 
 //////////////////////////////////////////////////////////////////////////
-bool BaseSurfaceStorage::sortSurfaces() {
-	Common::sort(_surfaces.begin(), _surfaces.end(), surfaceSortCB);
-	return STATUS_OK;
+void BaseSurfaceStorage::setBudget(int megabytes) {
+	// Clamp so the byte count still fits in 32 bits
+	_budget = megabytes > 0 ? (uint32)MIN(megabytes, 4095) * 1024 * 1024 : 0;
 }
 
 
 //////////////////////////////////////////////////////////////////////////
-bool BaseSurfaceStorage::surfaceSortCB(const BaseSurface *s1, const BaseSurface *s2) {
-	// sort by life time
-	if (s1->_lifeTime <= 0 && s2->_lifeTime > 0) {
-		return false;
-	} else if (s1->_lifeTime > 0 && s2->_lifeTime <= 0) {
-		return true;
+void BaseSurfaceStorage::getStats(Stats *stats) const {
+	stats->numSurfaces = _surfaces.size();
+	stats->numLoaded = 0;
+	stats->loadedBytes = 0;
+	for (SurfaceMap::const_iterator it = _surfaces.begin(); it != _surfaces.end(); ++it) {
+		uint32 size = it->_value->getLoadedSize();
+		if (size) {
+			stats->numLoaded++;
+			stats->loadedBytes += size;
+		}
 	}
+	stats->peakBytes = MAX(_peakBytes, stats->loadedBytes);
+	stats->budget = _budget;
+	stats->hits = _hits;
+	stats->misses = _misses;
+	stats->evictions = _evictions;
+}
 
 
-	// sort by validity
-	if (s1->_valid && !s2->_valid) {
-		return true;
-	} else if (!s1->_valid && s2->_valid) {
-		return false;
-	}
-
-	// sort by time
-	else if (s1->_lastUsedTime > s2->_lastUsedTime) {
-		return false;
-	} else if (s1->_lastUsedTime < s2->_lastUsedTime) {
-		return true;
-	} else {
-		return false;
-	}
+//////////////////////////////////////////////////////////////////////////
+bool BaseSurfaceStorage::surfaceSortCB(const BaseSurface *s1, const BaseSurface *s2) {
+	// least recently drawn first
+	return s1->_lastUsedTime < s2->_lastUsedTime;
 }
 
 } // End of namespace Wintermute
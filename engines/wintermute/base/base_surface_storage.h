@@ -30,14 +30,31 @@
 
 #include "engines/wintermute/base/base.h"
 #include "common/array.h"
+#include "common/hash-str.h"
 
 namespace Wintermute {
+
+// Default limit for decoded image data, in megabytes
+#define SURFACE_CACHE_BUDGET 256
+// Surfaces drawn more recently than this (in ms) are never evicted
+#define SURFACE_MIN_IDLE_TIME 1000
+
 class BaseSurface;
 class BaseSurfaceStorage : public BaseClass {
 public:
+	struct Stats {
+		uint32 numSurfaces;
+		uint32 numLoaded;
+		uint32 loadedBytes;
+		uint32 peakBytes;
+		uint32 budget;
+		uint32 hits;
+		uint32 misses;
+		uint32 evictions;
+	};
+
 	uint32 _lastCleanupTime;
 	bool initLoop();
-	bool sortSurfaces();
 	static bool surfaceSortCB(const BaseSurface *arg1, const BaseSurface *arg2);
 	bool cleanup(bool warn = false);
 	//DECLARE_PERSISTENT(BaseSurfaceStorage, BaseClass);
@@ -48,7 +65,26 @@ public:
 	BaseSurfaceStorage(BaseGame *inGame);
 	~BaseSurfaceStorage() override;
 
-	Common::Array<BaseSurface *> _surfaces;
+	/** Set the limit for decoded image data in megabytes, 0 or less disables it */
+	void setBudget(int megabytes);
+	void getStats(Stats *stats) const;
+
+	typedef Common::HashMap<Common::String, BaseSurface *, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> SurfaceMap;
+	SurfaceMap _surfaces;
+
+private:
+	/**
+	 * Drop the pixels of surfaces whose life time ran out (when @p expire
+	 * is set), then of the least recently drawn ones until the decoded
+	 * images fit in the budget again.
+	 */
+	void evictSurfaces(uint32 now, bool expire);
+
+	uint32 _budget;
+	uint32 _peakBytes;
+	uint32 _hits;
+	uint32 _misses;
+	uint32 _evictions;
 };
 
 } // End of namespace Wintermute
@@ -76,7 +76,12 @@ public:
 	virtual int getHeight() {
 		return _height;
 	}
+	/** Return the number of bytes of decoded pixel data currently held */
+	virtual uint32 getLoadedSize() {
+		return _valid ? _width * _height * 4 : 0;
+	}
 	Common::String getFileNameStr() { return _filename; }
+	bool isKeepLoaded() const { return _keepLoaded; }
 	const char* getFileName() { return _filename.c_str(); }
 	//void SetWidth(int Width) { _width = Width;    }
 	//void SetHeight(int Height){ _height = Height; }
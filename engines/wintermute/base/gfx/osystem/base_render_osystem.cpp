@@ -40,6 +40,8 @@
 #include "common/config-manager.h"
 
 #define DIRTY_RECT_LIMIT 800
+// Past this many rects the dirty region is replaced by its bounding box
+#define MAX_DIRTY_RECTS 32
 
 namespace Wintermute {
 
@@ -57,7 +59,6 @@ BaseRenderOSystem::BaseRenderOSystem(BaseGame *inGame) : BaseRenderer(inGame) {
 
 	_borderLeft = _borderRight = _borderTop = _borderBottom = 0;
 	_ratioX = _ratioY = 1.0f;
-	_dirtyRect = nullptr;
 	_disableDirtyRects = false;
 	if (ConfMan.hasKey("dirty_rects")) {
 		_disableDirtyRects = !ConfMan.getBool("dirty_rects");
@@ -75,8 +76,6 @@ BaseRenderOSystem::~BaseRenderOSystem() {
 		delete ticket;
 	}
 
-	delete _dirtyRect;
-
 	_renderSurface->free();
 	delete _renderSurface;
 	_blankSurface->free();
@@ -158,8 +157,7 @@ bool BaseRenderOSystem::forcedFlip() {
 bool BaseRenderOSystem::flip() {
 	if (_skipThisFrame) {
 		_skipThisFrame = false;
-		delete _dirtyRect;
-		_dirtyRect = nullptr;
+		_dirtyRegion.clear();
 		g_system->updateScreen();
 		_needsFlip = false;
 
@@ -169,6 +167,7 @@ bool BaseRenderOSystem::flip() {
 		for (it = _renderQueue.begin(); it != _renderQueue.end(); ++it) {
 			(*it)->_wantsDraw = false;
 		}
+		buildTicketIndex();
 
 		addDirtyRect(_renderRect);
 		return true;
@@ -198,9 +197,7 @@ bool BaseRenderOSystem::flip() {
 		if (_disableDirtyRects || screenChanged) {
 			g_system->copyRectToScreen((byte *)_renderSurface->getPixels(), _renderSurface->pitch, 0, 0, _renderSurface->w, _renderSurface->h);
 		}
-		//  g_system->copyRectToScreen((byte *)_renderSurface->getPixels(), _renderSurface->pitch, _dirtyRect->left, _dirtyRect->top, _dirtyRect->width(), _dirtyRect->height());
-		delete _dirtyRect;
-		_dirtyRect = nullptr;
+		_dirtyRegion.clear();
 		_needsFlip = false;
 	}
 	_lastFrameIter = _renderQueue.end();
@@ -302,22 +299,10 @@ void BaseRenderOSystem::drawSurface(BaseSurfaceOSystem *owner, const Graphics::S
 
 	if (owner) { // Fade-tickets are owner-less
 		RenderTicket compare(owner, nullptr, srcRect, dstRect, transform);
-		RenderQueueIterator it = _lastFrameIter;
-		++it;
-		// Avoid calling end() and operator* every time, when potentially going through
-		// LOTS of tickets.
-		RenderQueueIterator endIterator = _renderQueue.end();
-		RenderTicket *compareTicket = nullptr;
-		for (; it != endIterator; ++it) {
-			compareTicket = *it;
-			if (*(compareTicket) == compare && compareTicket->_isValid) {
-				if (_disableDirtyRects) {
-					drawFromSurface(compareTicket);
-				} else {
-					drawFromQueuedTicket(it);
-				}
-				return;
-			}
+		RenderQueueIterator it;
+		if (findLastFrameTicket(compare, it)) {
+			drawFromQueuedTicket(it);
+			return;
 		}
 	}
 	RenderTicket *ticket = new RenderTicket(owner, surf, srcRect, dstRect, transform);
@@ -381,13 +366,50 @@ void BaseRenderOSystem::drawFromQueuedTicket(const RenderQueueIterator &ticket)
 	}
 }
 
+bool BaseRenderOSystem::findLastFrameTicket(const RenderTicket &compare, RenderQueueIterator &pos) const {
+	TicketIndex::const_iterator bucket = _ticketIndex.find(compare.getHash());
+	if (bucket == _ticketIndex.end()) {
+		return false;
+	}
+
+	// The bucket is in queue order, and tickets already drawn this frame
+	// want to be drawn, so the first free match is the one a scan of the
+	// queue would have found.
+	const Common::Array<IndexedTicket> &tickets = bucket->_value;
+	for (uint i = 0; i < tickets.size(); i++) {
+		RenderTicket *ticket = tickets[i].ticket;
+		if (!ticket->_wantsDraw && ticket->_isValid && *ticket == compare) {
+			pos = tickets[i].pos;
+			return true;
+		}
+	}
+	return false;
+}
+
+void BaseRenderOSystem::buildTicketIndex() {
+	_ticketIndex.clear();
+	for (RenderQueueIterator it = _renderQueue.begin(); it != _renderQueue.end(); ++it) {
+		// Fade-tickets are never reused
+		if (!(*it)->_owner || !(*it)->_isValid) {
+			continue;
+		}
+
+		IndexedTicket entry;
+		entry.ticket = *it;
+		entry.pos = it;
+		_ticketIndex[entry.ticket->getHash()].push_back(entry);
+	}
+}
+
 void BaseRenderOSystem::addDirtyRect(const Common::Rect &rect) {
-	if (!_dirtyRect) {
-		_dirtyRect = new Common::Rect(rect);
-	} else {
-		_dirtyRect->extend(rect);
+	Common::Rect clipped(rect);
+	clipped.clip(_renderRect);
+	_dirtyRegion.unite(clipped);
+
+	// Every ticket is clipped against every rect, so don't let them pile up
+	if (_dirtyRegion.size() > MAX_DIRTY_RECTS) {
+		_dirtyRegion = Common::Region(_dirtyRegion.getBounds());
 	}
-	_dirtyRect->clip(_renderRect);
 }
 
 void BaseRenderOSystem::drawTickets() {
@@ -406,13 +428,14 @@ void BaseRenderOSystem::drawTickets() {
 			++it;
 		}
 	}
-	if (!_dirtyRect || _dirtyRect->width() == 0 || _dirtyRect->height() == 0) {
+	if (_dirtyRegion.isEmpty()) {
 		it = _renderQueue.begin();
 		while (it != _renderQueue.end()) {
 			RenderTicket *ticket = *it;
 			ticket->_wantsDraw = false;
 			++it;
 		}
+		buildTicketIndex();
 		return;
 	}
 
@@ -421,38 +444,45 @@ void BaseRenderOSystem::drawTickets() {
 	// A special case: If the screen has one giant OPAQUE rect to be drawn, then we skip filling
 	// the background color. Typical use-case: Fullscreen FMVs.
 	// Caveat: The FPS-counter will invalidate this.
+	bool skipFill = false;
 	if (it != _lastFrameIter && _renderQueue.front() == _renderQueue.back() && (*it)->_transform._alphaDisable == true) {
-		// If our single opaque rect fills the dirty rect, we can skip filling.
-		if (*_dirtyRect != (*it)->_dstRect) {
-			// Apply the clear-color to the dirty rect.
-			_renderSurface->fillRect(*_dirtyRect, _clearColor);
+		// If our single opaque rect fills the dirty region, we can skip filling.
+		skipFill = _dirtyRegion == Common::Region((*it)->_dstRect);
+	}
+	if (!skipFill) {
+		// Apply the clear-color to the dirty region.
+		for (Common::Region::const_iterator dirty = _dirtyRegion.begin(); dirty != _dirtyRegion.end(); ++dirty) {
+			_renderSurface->fillRect(*dirty, _clearColor);
 		}
-		// Otherwise Do NOT fill.
-	} else {
-		// Apply the clear-color to the dirty rect.
-		_renderSurface->fillRect(*_dirtyRect, _clearColor);
 	}
 	for (; it != _renderQueue.end(); ++it) {
 		RenderTicket *ticket = *it;
-		if (ticket->_dstRect.intersects(*_dirtyRect)) {
-			// dstClip is the area we want redrawn.
-			Common::Rect dstClip(ticket->_dstRect);
-			// reduce it to the dirty rect
-			dstClip.clip(*_dirtyRect);
-			// we need to keep track of the position to redraw the dirty rect
-			Common::Rect pos(dstClip);
-			int16 offsetX = ticket->_dstRect.left;
-			int16 offsetY = ticket->_dstRect.top;
-			// convert from screen-coords to surface-coords.
-			dstClip.translate(-offsetX, -offsetY);
-
-			drawFromSurface(ticket, &pos, &dstClip);
+		if (_dirtyRegion.intersects(ticket->_dstRect)) {
+			for (Common::Region::const_iterator dirty = _dirtyRegion.begin(); dirty != _dirtyRegion.end(); ++dirty) {
+				if (!ticket->_dstRect.intersects(*dirty)) {
+					continue;
+				}
+				// dstClip is the area we want redrawn.
+				Common::Rect dstClip(ticket->_dstRect);
+				// reduce it to the dirty rect
+				dstClip.clip(*dirty);
+				// we need to keep track of the position to redraw the dirty rect
+				Common::Rect pos(dstClip);
+				int16 offsetX = ticket->_dstRect.left;
+				int16 offsetY = ticket->_dstRect.top;
+				// convert from screen-coords to surface-coords.
+				dstClip.translate(-offsetX, -offsetY);
+
+				drawFromSurface(ticket, &pos, &dstClip);
+			}
 			_needsFlip = true;
 		}
 		// Some tickets want redraw but don't actually clip the dirty area (typically the ones that shouldnt become clear-color)
 		ticket->_wantsDraw = false;
 	}
-	g_system->copyRectToScreen((byte *)_renderSurface->getBasePtr(_dirtyRect->left, _dirtyRect->top), _renderSurface->pitch, _dirtyRect->left, _dirtyRect->top, _dirtyRect->width(), _dirtyRect->height());
+	for (Common::Region::const_iterator dirty = _dirtyRegion.begin(); dirty != _dirtyRegion.end(); ++dirty) {
+		g_system->copyRectToScreen((byte *)_renderSurface->getBasePtr(dirty->left, dirty->top), _renderSurface->pitch, dirty->left, dirty->top, dirty->width(), dirty->height());
+	}
 
 	it = _renderQueue.begin();
 	// Clean out the old tickets
@@ -467,6 +497,7 @@ void BaseRenderOSystem::drawTickets() {
 		}
 	}
 
+	buildTicketIndex();
 }
 
 // Replacement for SDL2's SDL_RenderCopy
@@ -588,6 +619,7 @@ void BaseRenderOSystem::endSaveLoad() {
 		it = _renderQueue.erase(it);
 		delete ticket;
 	}
+	_ticketIndex.clear();
 	// HACK: After a save the buffer will be drawn before the scripts get to update it,
 	// so just skip this single frame.
 	_skipThisFrame = true;
@@ -30,7 +30,9 @@
 
 #include "engines/wintermute/base/gfx/base_renderer.h"
 
+#include "common/hashmap.h"
 #include "common/rect.h"
+#include "common/region.h"
 #include "common/list.h"
 
 #include "graphics/surface.h"
@@ -54,6 +56,13 @@ class RenderTicket;
  * being equal, this information is then used to check whether the draw order changed,
  * which will then create a need for redrawing, as we draw with an alpha-channel here.
  *
+ * Last frame's tickets are indexed by RenderTicket::getHash(), so looking
+ * up an incoming draw-call does not depend on the size of the queue.
+ *
+ * The changed areas are kept as a Common::Region, so that unrelated
+ * changes in different corners of the screen don't have to repaint
+ * everything in between.
+ *
  * There is also a draw path that draws without tickets, for debugging purposes,
  * as well as to accomodate situations with large enough amounts of draw calls,
  * that there will be too much overhead involved with comparing the generated tickets.
@@ -122,6 +131,14 @@ private:
 	 * @param rect the region to be marked as dirty
 	 */
 	void addDirtyRect(const Common::Rect &rect);
+	/**
+	 * Index the tickets of the queue that can be reused next frame
+	 */
+	void buildTicketIndex();
+	/**
+	 * Find the first unused ticket from last frame that equals @p compare
+	 */
+	bool findLastFrameTicket(const RenderTicket &compare, RenderQueueIterator &pos) const;
 	/**
 	 * Traverse the tickets that are dirty, and draw them
 	 */
@@ -130,9 +147,16 @@ private:
 	void drawFromSurface(RenderTicket *ticket);
 	// Dirty-rects:
 	void drawFromSurface(RenderTicket *ticket, Common::Rect *dstRect, Common::Rect *clipRect);
-	Common::Rect *_dirtyRect;
+	Common::Region _dirtyRegion;
 	Common::List<RenderTicket *> _renderQueue;
 
+	struct IndexedTicket {
+		RenderTicket *ticket;
+		RenderQueueIterator pos;
+	};
+	typedef Common::HashMap<uint32, Common::Array<IndexedTicket> > TicketIndex;
+	TicketIndex _ticketIndex;
+
 	bool _needsFlip;
 	RenderQueueIterator _lastFrameIter;
 	Common::Rect _renderRect;
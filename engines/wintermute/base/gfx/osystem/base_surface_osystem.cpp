@@ -68,7 +68,9 @@ BaseSurfaceOSystem::~BaseSurfaceOSystem() {
 	delete[] _alphaMask;
 	_alphaMask = nullptr;
 
-	_gameRef->addMem(-_width * _height * 4);
+	if (_valid) {
+		_gameRef->addMem(-_width * _height * 4);
+	}
 	BaseRenderOSystem *renderer = static_cast<BaseRenderOSystem *>(_gameRef->_renderer);
 	renderer->invalidateTicketsFromSurface(this);
 }
@@ -216,10 +218,27 @@ bool BaseSurfaceOSystem::finishLoad() {
 	}
 
 	_loaded = true;
+	_lastUsedTime = _gameRef->getLiveTimer()->getTime();
 
 	return true;
 }
 
+//////////////////////////////////////////////////////////////////////////
+bool BaseSurfaceOSystem::invalidate() {
+	// Only images that came from a file can be loaded again on demand
+	if (!_loaded || _keepLoaded || _filename.empty() || _pixelOpReady) {
+		return STATUS_FAILED;
+	}
+
+	_surface->free();
+	_gameRef->addMem(-_width * _height * 4);
+
+	_loaded = false;
+	_valid = false;
+
+	return STATUS_OK;
+}
+
 //////////////////////////////////////////////////////////////////////////
 void BaseSurfaceOSystem::genAlphaMask(Graphics::Surface *surface) {
 	warning("BaseSurfaceOSystem::GenAlphaMask - Not ported yet");
@@ -321,6 +340,10 @@ bool BaseSurfaceOSystem::isTransparentAt(int x, int y) {
 
 //////////////////////////////////////////////////////////////////////////
 bool BaseSurfaceOSystem::isTransparentAtLite(int x, int y) {
+	if (!_loaded) {
+		finishLoad();
+	}
+
 	if (x < 0 || x >= _surface->w || y < 0 || y >= _surface->h) {
 		return true;
 	}
@@ -405,6 +428,7 @@ bool BaseSurfaceOSystem::drawSprite(int x, int y, Rect32 *rect, Rect32 *newRect,
 	if (!_loaded) {
 		finishLoad();
 	}
+	_lastUsedTime = _gameRef->getLiveTimer()->getTime();
 
 	if (renderer->_forceAlphaColor != 0) {
 		transform._rgbaMod = TS_COLOR(renderer->_forceAlphaColor);
@@ -457,6 +481,8 @@ bool BaseSurfaceOSystem::drawSprite(int x, int y, Rect32 *rect, Rect32 *newRect,
 
 bool BaseSurfaceOSystem::putSurface(const Graphics::Surface &surface, bool hasAlpha) {
 	_loaded = true;
+	// The pixels no longer match _filename, so they must never be dropped
+	_keepLoaded = true;
 	if (surface.format == _surface->format && surface.pitch == _surface->pitch && surface.h == _surface->h) {
 		const byte *src = (const byte *)surface.getBasePtr(0, 0);
 		byte *dst = (byte *)_surface->getBasePtr(0, 0);
@@ -45,6 +45,11 @@ public:
 	bool create(const Common::String &filename, bool defaultCK, byte ckRed, byte ckGreen, byte ckBlue, int lifeTime = -1, bool keepLoaded = false) override;
 	bool create(int width, int height) override;
 
+	bool invalidate() override;
+	uint32 getLoadedSize() override {
+		return _loaded ? _surface->pitch * _surface->h : 0;
+	}
+
 	bool isTransparentAt(int x, int y) override;
 	bool isTransparentAtLite(int x, int y) override;
 
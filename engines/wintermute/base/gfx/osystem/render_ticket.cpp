@@ -97,6 +97,17 @@ bool RenderTicket::operator==(const RenderTicket &t) const {
 	return true;
 }
 
+uint32 RenderTicket::getHash() const {
+	// The owner and the rects already tell nearly all tickets apart,
+	// the transform is left to operator==
+	uint32 hash = (uint32)(size_t)_owner;
+	hash = hash * 31 + (uint16)_dstRect.left + ((uint32)(uint16)_dstRect.top << 16);
+	hash = hash * 31 + (uint16)_dstRect.right + ((uint32)(uint16)_dstRect.bottom << 16);
+	hash = hash * 31 + (uint16)_srcRect.left + ((uint32)(uint16)_srcRect.top << 16);
+	hash = hash * 31 + (uint16)_srcRect.right + ((uint32)(uint16)_srcRect.bottom << 16);
+	return hash;
+}
+
 // Replacement for SDL2's SDL_RenderCopy
 void RenderTicket::drawToSurface(Graphics::Surface *_targetSurface) const {
 	Graphics::TransparentSurface src(*getSurface(), false);
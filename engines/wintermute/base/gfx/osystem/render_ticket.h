@@ -68,6 +68,8 @@ public:
 
 	BaseSurfaceOSystem *_owner;
 	bool operator==(const RenderTicket &a) const;
+	/** Hash of the fields compared by operator==, used to find last frame's ticket */
+	uint32 getHash() const;
 	const Common::Rect *getSrcRect() const { return &_srcRect; }
 private:
 	Graphics::Surface *_surface;
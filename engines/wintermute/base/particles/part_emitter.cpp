@@ -26,7 +26,6 @@
  */
 
 #include "engines/wintermute/base/particles/part_emitter.h"
-#include "engines/wintermute/base/particles/part_particle.h"
 #include "engines/wintermute/math/vector2.h"
 #include "engines/wintermute/math/matrix4.h"
 #include "engines/wintermute/base/scriptables/script_value.h"
@@ -94,11 +93,6 @@ PartEmitter::PartEmitter(BaseGame *inGame, BaseScriptHolder *owner) : BaseObject
 
 //////////////////////////////////////////////////////////////////////////
 PartEmitter::~PartEmitter(void) {
-	for (uint32 i = 0; i < _particles.size(); i++) {
-		delete _particles[i];
-	}
-	_particles.clear();
-
 	for (uint32 i = 0; i < _forces.size(); i++) {
 		delete _forces[i];
 	}
@@ -156,10 +150,7 @@ bool PartEmitter::removeSprite(const char *filename) {
 }
 
 //////////////////////////////////////////////////////////////////////////
-bool PartEmitter::initParticle(PartParticle *particle, uint32 currentTime, uint32 timerDelta) {
-	if (!particle) {
-		return STATUS_FAILED;
-	}
+bool PartEmitter::initParticle(uint32 slot, uint32 currentTime, uint32 timerDelta) {
 	if (_sprites.size() == 0) {
 		return STATUS_FAILED;
 	}
@@ -202,11 +193,12 @@ bool PartEmitter::initParticle(PartParticle *particle, uint32 currentTime, uint3
 		int thicknessTop    = (int)(_borderThicknessTop    - (float)_borderThicknessTop    * posZ / 100.0f);
 		int thicknessBottom = (int)(_borderThicknessBottom - (float)_borderThicknessBottom * posZ / 100.0f);
 
-		particle->_border = _border;
-		particle->_border.left += thicknessLeft;
-		particle->_border.right -= thicknessRight;
-		particle->_border.top += thicknessTop;
-		particle->_border.bottom -= thicknessBottom;
+		Rect32 &border = _particles._border[slot];
+		border = _border;
+		border.left += thicknessLeft;
+		border.right -= thicknessRight;
+		border.top += thicknessTop;
+		border.bottom -= thicknessBottom;
 	}
 
 	Vector2 vecPos((float)posX, (float)posY);
@@ -218,29 +210,31 @@ bool PartEmitter::initParticle(PartParticle *particle, uint32 currentTime, uint3
 	matRot.transformVector2(vecVel);
 
 	if (_alphaTimeBased) {
-		particle->_alpha1 = _alpha1;
-		particle->_alpha2 = _alpha2;
+		_particles._alpha1[slot] = _alpha1;
+		_particles._alpha2[slot] = _alpha2;
 	} else {
 		int alpha = BaseUtils::randomInt(_alpha1, _alpha2);
-		particle->_alpha1 = alpha;
-		particle->_alpha2 = alpha;
-	}
-
-	particle->_creationTime = currentTime;
-	particle->_pos = vecPos;
-	particle->_posZ = posZ;
-	particle->_velocity = vecVel;
-	particle->_scale = scale;
-	particle->_lifeTime = lifeTime;
-	particle->_rotation = rotation;
-	particle->_angVelocity = angVelocity;
-	particle->_growthRate = growthRate;
-	particle->_exponentialGrowth = _exponentialGrowth;
-	particle->_isDead = DID_FAIL(particle->setSprite(_sprites[spriteIndex]));
-	particle->fadeIn(currentTime, _fadeInTime);
-
-
-	if (particle->_isDead) {
+		_particles._alpha1[slot] = alpha;
+		_particles._alpha2[slot] = alpha;
+	}
+
+	_particles._creationTime[slot] = currentTime;
+	_particles._posX[slot] = vecPos.x;
+	_particles._posY[slot] = vecPos.y;
+	_particles._posZ[slot] = posZ;
+	_particles._velocityX[slot] = vecVel.x;
+	_particles._velocityY[slot] = vecVel.y;
+	_particles._scale[slot] = scale;
+	_particles._lifeTime[slot] = lifeTime;
+	_particles._rotation[slot] = rotation;
+	_particles._angVelocity[slot] = angVelocity;
+	_particles._growthRate[slot] = growthRate;
+	_particles._exponentialGrowth[slot] = _exponentialGrowth;
+	_particles._isDead[slot] = DID_FAIL(_particles.setSprite(this, slot, _sprites[spriteIndex]));
+	_particles.fadeIn(slot, currentTime, _fadeInTime);
+
+
+	if (_particles._isDead[slot]) {
 		return STATUS_FAILED;
 	} else {
 		return STATUS_OK;
@@ -258,15 +252,7 @@ bool PartEmitter::update() {
 
 //////////////////////////////////////////////////////////////////////////
 bool PartEmitter::updateInternal(uint32 currentTime, uint32 timerDelta) {
-	int numLive = 0;
-
-	for (uint32 i = 0; i < _particles.size(); i++) {
-		_particles[i]->update(this, currentTime, timerDelta);
-
-		if (!_particles[i]->_isDead) {
-			numLive++;
-		}
-	}
+	int numLive = _particles.update(this, currentTime, timerDelta);
 
 
 	// we're understaffed
@@ -281,23 +267,11 @@ bool PartEmitter::updateInternal(uint32 currentTime, uint32 timerDelta) {
 			}
 
 			int toGen = MIN(_genAmount, _maxParticles - numLive);
+			// dead slots before this position have been reused already
+			uint32 searchPos = 0;
 			while (toGen > 0) {
-				int firstDeadIndex = -1;
-				for (uint32 i = 0; i < _particles.size(); i++) {
-					if (_particles[i]->_isDead) {
-						firstDeadIndex = i;
-						break;
-					}
-				}
-
-				PartParticle *particle;
-				if (firstDeadIndex >= 0) {
-					particle = _particles[firstDeadIndex];
-				} else {
-					particle = new PartParticle(_gameRef);
-					_particles.add(particle);
-				}
-				initParticle(particle, currentTime, timerDelta);
+				uint32 slot = _particles.findDeadSlot(searchPos);
+				initParticle(slot, currentTime, timerDelta);
 				needsSort = true;
 
 				toGen--;
@@ -324,15 +298,7 @@ bool PartEmitter::display(BaseRegion *region) {
 		BaseEngine::getRenderer()->startSpriteBatch();
 	}
 
-	for (uint32 i = 0; i < _particles.size(); i++) {
-		if (region != nullptr && _useRegion) {
-			if (!region->pointInRegion((int)_particles[i]->_pos.x, (int)_particles[i]->_pos.y)) {
-				continue;
-			}
-		}
-
-		_particles[i]->display(this);
-	}
+	_particles.display(this, _useRegion ? region : nullptr);
 
 	if (_sprites.size() <= 1) {
 		BaseEngine::getRenderer()->endSpriteBatch();
@@ -343,9 +309,7 @@ bool PartEmitter::display(BaseRegion *region) {
 
 //////////////////////////////////////////////////////////////////////////
 bool PartEmitter::start() {
-	for (uint32 i = 0; i < _particles.size(); i++) {
-		_particles[i]->_isDead = true;
-	}
+	_particles.killAll();
 	_running = true;
 	_batchesGenerated = 0;
 
@@ -368,19 +332,10 @@ bool PartEmitter::start() {
 //////////////////////////////////////////////////////////////////////////
 bool PartEmitter::sortParticlesByZ() {
 	// sort particles by _posY
-	Common::sort(_particles.begin(), _particles.end(), PartEmitter::compareZ);
+	_particles.sortByZ();
 	return STATUS_OK;
 }
 
-//////////////////////////////////////////////////////////////////////////
-bool PartEmitter::compareZ(const PartParticle *p1, const PartParticle *p2) {
-	if (p1->_posZ < p2->_posZ) {
-		return true;
-	} else { // p1->_posZ >= p2->_posZ
-		return false;
-	}
-}
-
 //////////////////////////////////////////////////////////////////////////
 bool PartEmitter::setBorder(int x, int y, int width, int height) {
 	_border.setRect(x, y, x + width, y + height);
@@ -521,9 +476,6 @@ bool PartEmitter::scCallMethod(ScScript *script, ScStack *stack, ScStack *thisSt
 	else if (strcmp(name, "Stop") == 0) {
 		stack->correctParams(0);
 
-		for (uint32 i = 0; i < _particles.size(); i++) {
-			delete _particles[i];
-		}
 		_particles.clear();
 
 		_running = false;
@@ -783,13 +735,7 @@ ScValue *PartEmitter::scGetProperty(const Common::String &name) {
 	// NumLiveParticles (RO)
 	//////////////////////////////////////////////////////////////////////////
 	else if (name == "NumLiveParticles") {
-		int numAlive = 0;
-		for (uint32 i = 0; i < _particles.size(); i++) {
-			if (_particles[i] && !_particles[i]->_isDead) {
-				numAlive++;
-			}
-		}
-		_scValue->setInt(numAlive);
+		_scValue->setInt(_particles.getNumAlive());
 		return _scValue;
 	}
 
@@ -1231,21 +1177,7 @@ bool PartEmitter::persist(BasePersistenceManager *persistMgr) {
 		}
 	}
 
-	uint32 numParticles;
-	if (persistMgr->getIsSaving()) {
-		numParticles = _particles.size();
-		persistMgr->transferUint32(TMEMBER(numParticles));
-		for (uint32 i = 0; i < _particles.size(); i++) {
-			_particles[i]->persist(persistMgr);
-		}
-	} else {
-		persistMgr->transferUint32(TMEMBER(numParticles));
-		for (uint32 i = 0; i < numParticles; i++) {
-			PartParticle *particle = new PartParticle(_gameRef);
-			particle->persist(persistMgr);
-			_particles.add(particle);
-		}
-	}
+	_particles.persist(this, persistMgr);
 
 	return STATUS_OK;
 }
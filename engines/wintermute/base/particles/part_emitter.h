@@ -31,10 +31,10 @@
 
 #include "engines/wintermute/base/base_object.h"
 #include "engines/wintermute/base/particles/part_force.h"
+#include "engines/wintermute/base/particles/part_particle.h"
 
 namespace Wintermute {
 class BaseRegion;
-class PartParticle;
 class PartEmitter : public BaseObject {
 public:
 	DECLARE_PERSISTENT(PartEmitter, BaseObject)
@@ -126,11 +126,10 @@ private:
 	BaseScriptHolder *_owner;
 
 	PartForce *addForceByName(const Common::String &name);
-	bool static compareZ(const PartParticle *p1, const PartParticle *p2);
-	bool initParticle(PartParticle *particle, uint32 currentTime, uint32 timerDelta);
+	bool initParticle(uint32 slot, uint32 currentTime, uint32 timerDelta);
 	bool updateInternal(uint32 currentTime, uint32 timerDelta);
 	uint32 _lastGenTime;
-	BaseArray<PartParticle *> _particles;
+	PartParticlePool _particles;
 	BaseArray<char *> _sprites;
 };
 
@@ -27,64 +27,171 @@
 
 #include "engines/wintermute/base/particles/part_particle.h"
 #include "engines/wintermute/base/particles/part_emitter.h"
+#include "engines/wintermute/base/base_persistence_manager.h"
+#include "engines/wintermute/base/base_region.h"
 #include "engines/wintermute/base/base_sprite.h"
 #include "engines/wintermute/utils/utils.h"
 #include "engines/wintermute/platform_osystem.h"
+#include "common/algorithm.h"
 #include "common/str.h"
 
 namespace Wintermute {
 
 //////////////////////////////////////////////////////////////////////////
-PartParticle::PartParticle(BaseGame *inGame) : BaseClass(inGame) {
-	_pos = Vector2(0.0f, 0.0f);
-	_posZ = 0.0f;
-	_velocity = Vector2(0.0f, 0.0f);
-	_scale = 100.0f;
-	_sprite = nullptr;
-	_creationTime = 0;
-	_lifeTime = 0;
-	_isDead = true;
-	_border.setEmpty();
-
-	_state = PARTICLE_NORMAL;
-	_fadeStart = 0;
-	_fadeTime = 0;
-	_currentAlpha = 255;
-
-	_alpha1 = _alpha2 = 255;
-
-	_rotation = 0.0f;
-	_angVelocity = 0.0f;
-
-	_growthRate = 0.0f;
-	_exponentialGrowth = false;
+PartParticlePool::PartParticlePool() {
 }
 
 
 //////////////////////////////////////////////////////////////////////////
-PartParticle::~PartParticle(void) {
-	delete _sprite;
-	_sprite = nullptr;
+PartParticlePool::~PartParticlePool() {
+	clear();
 }
 
+
+//////////////////////////////////////////////////////////////////////////
+uint32 PartParticlePool::addSlot() {
+	uint32 slot = _order.size();
+
+	_posX.push_back(0.0f);
+	_posY.push_back(0.0f);
+	_posZ.push_back(0.0f);
+	_velocityX.push_back(0.0f);
+	_velocityY.push_back(0.0f);
+	_scale.push_back(100.0f);
+	_growthRate.push_back(0.0f);
+	_exponentialGrowth.push_back(false);
+	_rotation.push_back(0.0f);
+	_angVelocity.push_back(0.0f);
+
+	_alpha1.push_back(255);
+	_alpha2.push_back(255);
+	Rect32 border;
+	border.setEmpty();
+	_border.push_back(border);
+	_sprite.push_back(nullptr);
+	_creationTime.push_back(0);
+	_lifeTime.push_back(0);
+	_isDead.push_back(true);
+
+	_state.push_back(PARTICLE_NORMAL);
+	_fadeStart.push_back(0);
+	_fadeTime.push_back(0);
+	_currentAlpha.push_back(255);
+	_fadeStartAlpha.push_back(0);
+
+	_order.push_back(slot);
+	return slot;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+void PartParticlePool::clear() {
+	for (uint32 i = 0; i < _sprite.size(); i++) {
+		delete _sprite[i];
+	}
+
+	_posX.clear();
+	_posY.clear();
+	_posZ.clear();
+	_velocityX.clear();
+	_velocityY.clear();
+	_scale.clear();
+	_growthRate.clear();
+	_exponentialGrowth.clear();
+	_rotation.clear();
+	_angVelocity.clear();
+
+	_alpha1.clear();
+	_alpha2.clear();
+	_border.clear();
+	_sprite.clear();
+	_creationTime.clear();
+	_lifeTime.clear();
+	_isDead.clear();
+
+	_state.clear();
+	_fadeStart.clear();
+	_fadeTime.clear();
+	_currentAlpha.clear();
+	_fadeStartAlpha.clear();
+
+	_order.clear();
+	_moving.clear();
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+void PartParticlePool::killAll() {
+	for (uint32 i = 0; i < _isDead.size(); i++) {
+		_isDead[i] = true;
+	}
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+uint32 PartParticlePool::getNumAlive() const {
+	uint32 numAlive = 0;
+	for (uint32 i = 0; i < _isDead.size(); i++) {
+		if (!_isDead[i]) {
+			numAlive++;
+		}
+	}
+	return numAlive;
+}
+
+
 //////////////////////////////////////////////////////////////////////////
-bool PartParticle::setSprite(const Common::String &filename) {
-	if (_sprite && _sprite->getFilename() && scumm_stricmp(filename.c_str(), _sprite->getFilename()) == 0) {
-		_sprite->reset();
+uint32 PartParticlePool::findDeadSlot(uint32 &pos) {
+	for (; pos < _order.size(); pos++) {
+		if (_isDead[_order[pos]]) {
+			return _order[pos];
+		}
+	}
+	return addSlot();
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+namespace {
+
+struct CompareZ {
+	const float *_posZ;
+
+	CompareZ(const float *posZ) : _posZ(posZ) {}
+
+	bool operator()(uint32 slot1, uint32 slot2) const {
+		return _posZ[slot1] < _posZ[slot2];
+	}
+};
+
+} // End of anonymous namespace
+
+void PartParticlePool::sortByZ() {
+	if (!_order.empty()) {
+		Common::sort(_order.begin(), _order.end(), CompareZ(&_posZ[0]));
+	}
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+bool PartParticlePool::setSprite(PartEmitter *emitter, uint32 slot, const Common::String &filename) {
+	BaseSprite *&sprite = _sprite[slot];
+	if (sprite && sprite->getFilename() && scumm_stricmp(filename.c_str(), sprite->getFilename()) == 0) {
+		sprite->reset();
 		return STATUS_OK;
 	}
 
-	delete _sprite;
-	_sprite = nullptr;
+	delete sprite;
+	sprite = nullptr;
 
 	SystemClassRegistry::getInstance()->_disabled = true;
-	_sprite = new BaseSprite(_gameRef, (BaseObject*)_gameRef);
-	if (_sprite && DID_SUCCEED(_sprite->loadFile(filename))) {
+	sprite = new BaseSprite(emitter->_gameRef, (BaseObject*)emitter->_gameRef);
+	if (sprite && DID_SUCCEED(sprite->loadFile(filename))) {
 		SystemClassRegistry::getInstance()->_disabled = false;
 		return STATUS_OK;
 	} else {
-		delete _sprite;
-		_sprite = nullptr;
+		delete sprite;
+		sprite = nullptr;
 		SystemClassRegistry::getInstance()->_disabled = false;
 		return STATUS_FAILED;
 	}
@@ -92,177 +199,246 @@ bool PartParticle::setSprite(const Common::String &filename) {
 }
 
 //////////////////////////////////////////////////////////////////////////
-bool PartParticle::update(PartEmitter *emitter, uint32 currentTime, uint32 timerDelta) {
-	if (_state == PARTICLE_FADEIN) {
-		if (currentTime - _fadeStart >= (uint32)_fadeTime) {
-			_state = PARTICLE_NORMAL;
-			_currentAlpha = _alpha1;
-		} else {
-			_currentAlpha = (int)(((float)currentTime - (float)_fadeStart) / (float)_fadeTime * _alpha1);
+int PartParticlePool::update(PartEmitter *emitter, uint32 currentTime, uint32 timerDelta) {
+	uint32 count = size();
+	int numLive = 0;
+
+	// First the fades, life times and borders, which differ per particle.
+	// Dead particles are left alone, they are fully set up again when reused.
+	_moving.clear();
+	for (uint32 i = 0; i < count; i++) {
+		if (_isDead[i]) {
+			continue;
 		}
 
-		return STATUS_OK;
-	} else if (_state == PARTICLE_FADEOUT) {
-		if (currentTime - _fadeStart >= (uint32)_fadeTime) {
-			_isDead = true;
-			return STATUS_OK;
+		if (_state[i] == PARTICLE_FADEIN) {
+			if (currentTime - _fadeStart[i] >= (uint32)_fadeTime[i]) {
+				_state[i] = PARTICLE_NORMAL;
+				_currentAlpha[i] = _alpha1[i];
+			} else {
+				_currentAlpha[i] = (int)(((float)currentTime - (float)_fadeStart[i]) / (float)_fadeTime[i] * _alpha1[i]);
+			}
+		} else if (_state[i] == PARTICLE_FADEOUT) {
+			if (currentTime - _fadeStart[i] >= (uint32)_fadeTime[i]) {
+				_isDead[i] = true;
+			} else {
+				_currentAlpha[i] = _fadeStartAlpha[i] - (int)(((float)currentTime - (float)_fadeStart[i]) / (float)_fadeTime[i] * _fadeStartAlpha[i]);
+			}
 		} else {
-			_currentAlpha = _fadeStartAlpha - (int)(((float)currentTime - (float)_fadeStart) / (float)_fadeTime * _fadeStartAlpha);
-		}
+			// time is up
+			if (_lifeTime[i] > 0) {
+				if (currentTime - _creationTime[i] >= (uint32)_lifeTime[i]) {
+					if (emitter->_fadeOutTime > 0) {
+						fadeOut(i, currentTime, emitter->_fadeOutTime);
+					} else {
+						_isDead[i] = true;
+					}
+				}
+			}
 
-		return STATUS_OK;
-	} else {
-		// time is up
-		if (_lifeTime > 0) {
-			if (currentTime - _creationTime >= (uint32)_lifeTime) {
-				if (emitter->_fadeOutTime > 0) {
-					fadeOut(currentTime, emitter->_fadeOutTime);
-				} else {
-					_isDead = true;
+			// particle hit the border
+			if (!_isDead[i] && !_border[i].isRectEmpty()) {
+				Point32 p;
+				p.x = (int32)_posX[i];
+				p.y = (int32)_posY[i];
+				if (!BasePlatform::ptInRect(&_border[i], p)) {
+					fadeOut(i, currentTime, emitter->_fadeOutTime);
 				}
 			}
-		}
 
-		// particle hit the border
-		if (!_isDead && !_border.isRectEmpty()) {
-			Point32 p;
-			p.x = (int32)_pos.x;
-			p.y = (int32)_pos.y;
-			if (!BasePlatform::ptInRect(&_border, p)) {
-				fadeOut(currentTime, emitter->_fadeOutTime);
+			if (!_isDead[i] && _state[i] == PARTICLE_NORMAL) {
+				// update alpha
+				if (_lifeTime[i] > 0) {
+					int age = (int)(currentTime - _creationTime[i]);
+					int alphaDelta = (int)(_alpha2[i] - _alpha1[i]);
+
+					_currentAlpha[i] = _alpha1[i] + (int)(((float)alphaDelta / (float)_lifeTime[i] * (float)age));
+				}
+
+				_moving.push_back(i);
 			}
 		}
-		if (_state != PARTICLE_NORMAL) {
-			return STATUS_OK;
-		}
-
-		// update alpha
-		if (_lifeTime > 0) {
-			int age = (int)(currentTime - _creationTime);
-			int alphaDelta = (int)(_alpha2 - _alpha1);
 
-			_currentAlpha = _alpha1 + (int)(((float)alphaDelta / (float)_lifeTime * (float)age));
+		if (!_isDead[i]) {
+			numLive++;
 		}
+	}
 
-		// update position
-		float elapsedTime = (float)timerDelta / 1000.f;
+	if (_moving.empty()) {
+		return numLive;
+	}
 
-		for (uint32 i = 0; i < emitter->_forces.size(); i++) {
-			PartForce *force = emitter->_forces[i];
-			switch (force->_type) {
-			case PartForce::FORCE_GLOBAL:
-				_velocity += force->_direction * elapsedTime;
-				break;
+	// Then the movement, one property at a time over all moving particles.
+	// Forces are applied one after another, so every particle adds them up
+	// in the same order as before.
+	float elapsedTime = (float)timerDelta / 1000.f;
+	const uint32 *moving = &_moving[0];
+	uint32 numMoving = _moving.size();
+	float *posX = &_posX[0];
+	float *posY = &_posY[0];
+	float *velocityX = &_velocityX[0];
+	float *velocityY = &_velocityY[0];
+
+	for (uint32 f = 0; f < emitter->_forces.size(); f++) {
+		PartForce *force = emitter->_forces[f];
+		switch (force->_type) {
+		case PartForce::FORCE_GLOBAL: {
+			float deltaX = force->_direction.x * elapsedTime;
+			float deltaY = force->_direction.y * elapsedTime;
+			for (uint32 k = 0; k < numMoving; k++) {
+				uint32 i = moving[k];
+				velocityX[i] += deltaX;
+				velocityY[i] += deltaY;
+			}
+		}
+		break;
 
-			case PartForce::FORCE_POINT: {
-				Vector2 vecDist = force->_pos - _pos;
-				float dist = fabs(vecDist.length());
+		case PartForce::FORCE_POINT:
+			for (uint32 k = 0; k < numMoving; k++) {
+				uint32 i = moving[k];
+				float distX = force->_pos.x - posX[i];
+				float distY = force->_pos.y - posY[i];
+				float dist = fabs((float)sqrt(distX * distX + distY * distY));
 
 				dist = 100.0f / dist;
 
-				_velocity += force->_direction * dist * elapsedTime;
+				velocityX[i] += force->_direction.x * dist * elapsedTime;
+				velocityY[i] += force->_direction.y * dist * elapsedTime;
 			}
 			break;
 
-			default:
-				break;
-			}
+		default:
+			break;
 		}
-		_pos += _velocity * elapsedTime;
+	}
 
-		// update rotation
-		_rotation += _angVelocity * elapsedTime;
-		_rotation = BaseUtils::normalizeAngle(_rotation);
+	for (uint32 k = 0; k < numMoving; k++) {
+		uint32 i = moving[k];
+		posX[i] += velocityX[i] * elapsedTime;
+		posY[i] += velocityY[i] * elapsedTime;
+	}
+
+	// update rotation
+	for (uint32 k = 0; k < numMoving; k++) {
+		uint32 i = moving[k];
+		_rotation[i] += _angVelocity[i] * elapsedTime;
+		_rotation[i] = BaseUtils::normalizeAngle(_rotation[i]);
+	}
 
-		// update scale
-		if (_exponentialGrowth) {
-			_scale += _scale / 100.0f * _growthRate * elapsedTime;
+	// update scale
+	for (uint32 k = 0; k < numMoving; k++) {
+		uint32 i = moving[k];
+		if (_exponentialGrowth[i]) {
+			_scale[i] += _scale[i] / 100.0f * _growthRate[i] * elapsedTime;
 		} else {
-			_scale += _growthRate * elapsedTime;
+			_scale[i] += _growthRate[i] * elapsedTime;
 		}
 
-		if (_scale <= 0.0f) {
-			_isDead = true;
+		if (_scale[i] <= 0.0f) {
+			_isDead[i] = true;
+			numLive--;
 		}
-
-
-		return STATUS_OK;
 	}
+
+	return numLive;
 }
 
 //////////////////////////////////////////////////////////////////////////
-bool PartParticle::display(PartEmitter *emitter) {
-	if (!_sprite) {
-		return STATUS_FAILED;
-	}
-	if (_isDead) {
-		return STATUS_OK;
-	}
+void PartParticlePool::display(PartEmitter *emitter, BaseRegion *region) {
+	for (uint32 n = 0; n < _order.size(); n++) {
+		uint32 i = _order[n];
+		if (!_sprite[i] || _isDead[i]) {
+			continue;
+		}
+
+		if (region && !region->pointInRegion((int)_posX[i], (int)_posY[i])) {
+			continue;
+		}
 
-	_sprite->getCurrentFrame();
-	return _sprite->display((int)_pos.x, (int)_pos.y,
-	                        nullptr,
-	                        _scale, _scale,
-	                        BYTETORGBA(255, 255, 255, _currentAlpha),
-	                        _rotation,
-	                        emitter->_blendMode);
+		_sprite[i]->getCurrentFrame();
+		_sprite[i]->display((int)_posX[i], (int)_posY[i],
+		                    nullptr,
+		                    _scale[i], _scale[i],
+		                    BYTETORGBA(255, 255, 255, _currentAlpha[i]),
+		                    _rotation[i],
+		                    emitter->_blendMode);
+	}
 }
 
 
 //////////////////////////////////////////////////////////////////////////
-bool PartParticle::fadeIn(uint32 currentTime, int fadeTime) {
-	_currentAlpha = 0;
-	_fadeStart = currentTime;
-	_fadeTime = fadeTime;
-	_state = PARTICLE_FADEIN;
-
-	return STATUS_OK;
+void PartParticlePool::fadeIn(uint32 slot, uint32 currentTime, int fadeTime) {
+	_currentAlpha[slot] = 0;
+	_fadeStart[slot] = currentTime;
+	_fadeTime[slot] = fadeTime;
+	_state[slot] = PARTICLE_FADEIN;
 }
 
 //////////////////////////////////////////////////////////////////////////
-bool PartParticle::fadeOut(uint32 currentTime, int fadeTime) {
-	//_currentAlpha = 255;
-	_fadeStartAlpha = _currentAlpha;
-	_fadeStart = currentTime;
-	_fadeTime = fadeTime;
-	_state = PARTICLE_FADEOUT;
-
-	return STATUS_OK;
+void PartParticlePool::fadeOut(uint32 slot, uint32 currentTime, int fadeTime) {
+	_fadeStartAlpha[slot] = _currentAlpha[slot];
+	_fadeStart[slot] = currentTime;
+	_fadeTime[slot] = fadeTime;
+	_state[slot] = PARTICLE_FADEOUT;
 }
 
 //////////////////////////////////////////////////////////////////////////
-bool PartParticle::persist(BasePersistenceManager *persistMgr) {
-	persistMgr->transferSint32(TMEMBER(_alpha1));
-	persistMgr->transferSint32(TMEMBER(_alpha2));
-	persistMgr->transferRect32(TMEMBER(_border));
-	persistMgr->transferVector2(TMEMBER(_pos));
-	persistMgr->transferFloat(TMEMBER(_posZ));
-	persistMgr->transferVector2(TMEMBER(_velocity));
-	persistMgr->transferFloat(TMEMBER(_scale));
-	persistMgr->transferUint32(TMEMBER(_creationTime));
-	persistMgr->transferSint32(TMEMBER(_lifeTime));
-	persistMgr->transferBool(TMEMBER(_isDead));
-	persistMgr->transferSint32(TMEMBER_INT(_state));
-	persistMgr->transferUint32(TMEMBER(_fadeStart));
-	persistMgr->transferSint32(TMEMBER(_fadeTime));
-	persistMgr->transferSint32(TMEMBER(_currentAlpha));
-	persistMgr->transferFloat(TMEMBER(_angVelocity));
-	persistMgr->transferFloat(TMEMBER(_rotation));
-	persistMgr->transferFloat(TMEMBER(_growthRate));
-	persistMgr->transferBool(TMEMBER(_exponentialGrowth));
-	persistMgr->transferSint32(TMEMBER(_fadeStartAlpha));
-
+bool PartParticlePool::persist(PartEmitter *emitter, BasePersistenceManager *persistMgr) {
+	// Same layout as the old per-particle objects: the count, then each
+	// particle in drawing order
+	uint32 numParticles;
 	if (persistMgr->getIsSaving()) {
-		const char *filename = _sprite->getFilename();
-		persistMgr->transferConstChar(TMEMBER(filename));
+		numParticles = _order.size();
 	} else {
-		char *filename;
-		persistMgr->transferCharPtr(TMEMBER(filename));
-		SystemClassRegistry::getInstance()->_disabled = true;
-		setSprite(filename);
-		SystemClassRegistry::getInstance()->_disabled = false;
-		delete[] filename;
-		filename = nullptr;
+		clear();
+	}
+	persistMgr->transferUint32(TMEMBER(numParticles));
+
+	for (uint32 n = 0; n < numParticles; n++) {
+		uint32 i = persistMgr->getIsSaving() ? _order[n] : addSlot();
+
+		Vector2 pos(_posX[i], _posY[i]);
+		Vector2 velocity(_velocityX[i], _velocityY[i]);
+		int32 state = _state[i];
+
+		persistMgr->transferSint32("_alpha1", &_alpha1[i]);
+		persistMgr->transferSint32("_alpha2", &_alpha2[i]);
+		persistMgr->transferRect32("_border", &_border[i]);
+		persistMgr->transferVector2("_pos", &pos);
+		persistMgr->transferFloat("_posZ", &_posZ[i]);
+		persistMgr->transferVector2("_velocity", &velocity);
+		persistMgr->transferFloat("_scale", &_scale[i]);
+		persistMgr->transferUint32("_creationTime", &_creationTime[i]);
+		persistMgr->transferSint32("_lifeTime", &_lifeTime[i]);
+		persistMgr->transferBool("_isDead", &_isDead[i]);
+		persistMgr->transferSint32("_state", &state);
+		persistMgr->transferUint32("_fadeStart", &_fadeStart[i]);
+		persistMgr->transferSint32("_fadeTime", &_fadeTime[i]);
+		persistMgr->transferSint32("_currentAlpha", &_currentAlpha[i]);
+		persistMgr->transferFloat("_angVelocity", &_angVelocity[i]);
+		persistMgr->transferFloat("_rotation", &_rotation[i]);
+		persistMgr->transferFloat("_growthRate", &_growthRate[i]);
+		persistMgr->transferBool("_exponentialGrowth", &_exponentialGrowth[i]);
+		persistMgr->transferSint32("_fadeStartAlpha", &_fadeStartAlpha[i]);
+
+		if (persistMgr->getIsSaving()) {
+			const char *filename = _sprite[i] ? _sprite[i]->getFilename() : "";
+			persistMgr->transferConstChar(TMEMBER(filename));
+		} else {
+			_posX[i] = pos.x;
+			_posY[i] = pos.y;
+			_velocityX[i] = velocity.x;
+			_velocityY[i] = velocity.y;
+			_state[i] = state;
+
+			char *filename;
+			persistMgr->transferCharPtr(TMEMBER(filename));
+			SystemClassRegistry::getInstance()->_disabled = true;
+			setSprite(emitter, i, filename);
+			SystemClassRegistry::getInstance()->_disabled = false;
+			delete[] filename;
+			filename = nullptr;
+		}
 	}
 
 	return STATUS_OK;
@@ -31,57 +31,94 @@
 
 #include "engines/wintermute/base/base.h"
 #include "engines/wintermute/math/rect32.h"
-#include "engines/wintermute/math/vector2.h"
+#include "common/array.h"
 
 namespace Wintermute {
 
 class PartEmitter;
+class BaseRegion;
 class BaseSprite;
 class BasePersistenceManager;
 
-class PartParticle : public BaseClass {
+/**
+ * All particles of one emitter.
+ *
+ * Every particle property is kept in its own array, indexed by slot, so
+ * that the per-frame update walks packed floats instead of chasing one
+ * heap object per particle. Dead slots are kept for reuse. The drawing
+ * order is a separate list of slots, which is what gets sorted by Z.
+ * The pool is owned by its emitter, which is passed to everything that
+ * needs the emitter settings or the game.
+ */
+class PartParticlePool {
 public:
 	enum TParticleState {
 	    PARTICLE_NORMAL, PARTICLE_FADEIN, PARTICLE_FADEOUT
 	};
 
-	PartParticle(BaseGame *inGame);
-	~PartParticle(void) override;
-
-	float _growthRate;
-	bool _exponentialGrowth;
-
-	float _rotation;
-	float _angVelocity;
-
-	int32 _alpha1;
-	int32 _alpha2;
-
-	Rect32 _border;
-	Vector2 _pos;
-	float _posZ;
-	Vector2 _velocity;
-	float _scale;
-	BaseSprite *_sprite;
-	uint32 _creationTime;
-	int32 _lifeTime;
-	bool _isDead;
-	TParticleState _state;
-
-	bool update(PartEmitter *emitter, uint32 currentTime, uint32 timerDelta);
-	bool display(PartEmitter *emitter);
-
-	bool setSprite(const Common::String &filename);
-
-	bool fadeIn(uint32 currentTime, int fadeTime);
-	bool fadeOut(uint32 currentTime, int fadeTime);
+	PartParticlePool();
+	~PartParticlePool();
+
+	/** Number of slots, dead or alive */
+	uint32 size() const {
+		return _order.size();
+	}
+	uint32 getNumAlive() const;
+
+	/**
+	 * Return the slot of the first dead particle at or after drawing
+	 * position @p pos, adding a new slot if there is none. @p pos is
+	 * updated to the position of the returned slot.
+	 */
+	uint32 findDeadSlot(uint32 &pos);
+
+	void clear();
+	void killAll();
+	void sortByZ();
+
+	/** Advance all particles, return the number still alive */
+	int update(PartEmitter *emitter, uint32 currentTime, uint32 timerDelta);
+	void display(PartEmitter *emitter, BaseRegion *region);
+
+	bool setSprite(PartEmitter *emitter, uint32 slot, const Common::String &filename);
+
+	void fadeIn(uint32 slot, uint32 currentTime, int fadeTime);
+	void fadeOut(uint32 slot, uint32 currentTime, int fadeTime);
+
+	bool persist(PartEmitter *emitter, BasePersistenceManager *persistMgr);
+
+	Common::Array<float> _posX;
+	Common::Array<float> _posY;
+	Common::Array<float> _posZ;
+	Common::Array<float> _velocityX;
+	Common::Array<float> _velocityY;
+	Common::Array<float> _scale;
+	Common::Array<float> _growthRate;
+	Common::Array<bool> _exponentialGrowth;
+	Common::Array<float> _rotation;
+	Common::Array<float> _angVelocity;
+
+	Common::Array<int32> _alpha1;
+	Common::Array<int32> _alpha2;
+	Common::Array<Rect32> _border;
+	Common::Array<BaseSprite *> _sprite;
+	Common::Array<uint32> _creationTime;
+	Common::Array<int32> _lifeTime;
+	Common::Array<bool> _isDead;
 
-	bool persist(BasePersistenceManager *PersistMgr) override;
 private:
-	uint32 _fadeStart;
-	int32 _fadeTime;
-	int32 _currentAlpha;
-	int32 _fadeStartAlpha;
+	uint32 addSlot();
+
+	Common::Array<byte> _state;
+	Common::Array<uint32> _fadeStart;
+	Common::Array<int32> _fadeTime;
+	Common::Array<int32> _currentAlpha;
+	Common::Array<int32> _fadeStartAlpha;
+
+	// Slots in drawing order
+	Common::Array<uint32> _order;
+	// Slots that move this frame, reused between updates
+	Common::Array<uint32> _moving;
 };
 
 } // End of namespace Wintermute
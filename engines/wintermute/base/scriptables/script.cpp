@@ -49,7 +49,6 @@ IMPLEMENT_PERSISTENT(ScScript, false)
 
 //////////////////////////////////////////////////////////////////////////
 ScScript::ScScript(BaseGame *inGame, ScEngine *engine) : BaseClass(inGame) {
-	_buffer = nullptr;
 	_bufferSize = _iP = 0;
 	_scriptStream = nullptr;
 	_filename = nullptr;
@@ -133,7 +132,7 @@ void ScScript::readHeader() {
 //////////////////////////////////////////////////////////////////////////
 bool ScScript::initScript() {
 	if (!_scriptStream) {
-		_scriptStream = new Common::MemoryReadStream(_buffer, _bufferSize);
+		_scriptStream = new Common::MemoryReadStream(_buffer.get(), _bufferSize);
 	}
 	readHeader();
 
@@ -249,7 +248,7 @@ bool ScScript::initTables() {
 
 
 //////////////////////////////////////////////////////////////////////////
-bool ScScript::create(const char *filename, byte *buffer, uint32 size, BaseScriptHolder *owner) {
+bool ScScript::create(const char *filename, const Common::SharedPtr<byte> &buffer, uint32 size, BaseScriptHolder *owner) {
 	cleanup();
 
 	_thread = false;
@@ -263,13 +262,11 @@ bool ScScript::create(const char *filename, byte *buffer, uint32 size, BaseScrip
 		strcpy(_filename, filename);
 	}
 
-	_buffer = new byte [size];
-	if (!_buffer) {
+	if (!buffer) {
 		return STATUS_FAILED;
 	}
 
-	memcpy(_buffer, buffer, size);
-
+	_buffer = buffer;
 	_bufferSize = size;
 
 	bool res = initScript();
@@ -303,13 +300,8 @@ bool ScScript::createThread(ScScript *original, uint32 initIP, const Common::Str
 		strcpy(_filename, original->_filename);
 	}
 
-	// copy buffer
-	_buffer = new byte [original->_bufferSize];
-	if (!_buffer) {
-		return STATUS_FAILED;
-	}
-
-	memcpy(_buffer, original->_buffer, original->_bufferSize);
+	// share buffer, the bytecode is never modified
+	_buffer = original->_buffer;
 	_bufferSize = original->_bufferSize;
 
 	// initialize
@@ -360,13 +352,8 @@ bool ScScript::createMethodThread(ScScript *original, const Common::String &meth
 		strcpy(_filename, original->_filename);
 	}
 
-	// copy buffer
-	_buffer = new byte [original->_bufferSize];
-	if (!_buffer) {
-		return STATUS_FAILED;
-	}
-
-	memcpy(_buffer, original->_buffer, original->_bufferSize);
+	// share buffer, the bytecode is never modified
+	_buffer = original->_buffer;
 	_bufferSize = original->_bufferSize;
 
 	// initialize
@@ -394,10 +381,7 @@ bool ScScript::createMethodThread(ScScript *original, const Common::String &meth
 
 //////////////////////////////////////////////////////////////////////////
 void ScScript::cleanup() {
-	if (_buffer) {
-		delete[] _buffer;
-	}
-	_buffer = nullptr;
+	_buffer.reset();
 
 	if (_filename) {
 		delete[] _filename;
@@ -511,8 +495,8 @@ double ScScript::getFloat() {
 
 //////////////////////////////////////////////////////////////////////////
 char *ScScript::getString() {
-	char *ret = (char *)(_buffer + _iP);
-	while (*(char *)(_buffer + _iP) != '\0') {
+	char *ret = (char *)(_buffer.get() + _iP);
+	while (*(char *)(_buffer.get() + _iP) != '\0') {
 		_iP++;
 	}
 	_iP++; // string terminator
@@ -1314,7 +1298,7 @@ bool ScScript::persist(BasePersistenceManager *persistMgr) {
 	if (persistMgr->getIsSaving()) {
 		if (_state != SCRIPT_PERSISTENT && _state != SCRIPT_FINISHED && _state != SCRIPT_THREAD_FINISHED) {
 			persistMgr->transferUint32(TMEMBER(_bufferSize));
-			persistMgr->putBytes(_buffer, _bufferSize);
+			persistMgr->putBytes(_buffer.get(), _bufferSize);
 		} else {
 			// don't save idle/finished scripts
 			int32 bufferSize = 0;
@@ -1323,12 +1307,12 @@ bool ScScript::persist(BasePersistenceManager *persistMgr) {
 	} else {
 		persistMgr->transferUint32(TMEMBER(_bufferSize));
 		if (_bufferSize > 0) {
-			_buffer = new byte[_bufferSize];
-			persistMgr->getBytes(_buffer, _bufferSize);
-			_scriptStream = new Common::MemoryReadStream(_buffer, _bufferSize);
+			_buffer = Common::SharedPtr<byte>(new byte[_bufferSize], ScBufferDeleter());
+			persistMgr->getBytes(_buffer.get(), _bufferSize);
+			_scriptStream = new Common::MemoryReadStream(_buffer.get(), _bufferSize);
 			initTables();
 		} else {
-			_buffer = nullptr;
+			_buffer.reset();
 			_scriptStream = nullptr;
 		}
 	}
@@ -1514,19 +1498,16 @@ bool ScScript::finishThreads() {
 
 //////////////////////////////////////////////////////////////////////////
 void ScScript::afterLoad() {
-	if (_buffer == nullptr) {
-		byte *buffer = _engine->getCompiledScript(_filename, &_bufferSize);
-		if (!buffer) {
+	if (!_buffer) {
+		_buffer = _engine->getCompiledBuffer(_filename, &_bufferSize);
+		if (!_buffer) {
 			_gameRef->LOG(0, "Error reinitializing script '%s' after load. Script will be terminated.", _filename);
 			_state = SCRIPT_ERROR;
 			return;
 		}
 
-		_buffer = new byte [_bufferSize];
-		memcpy(_buffer, buffer, _bufferSize);
-
 		delete _scriptStream;
-		_scriptStream = new Common::MemoryReadStream(_buffer, _bufferSize);
+		_scriptStream = new Common::MemoryReadStream(_buffer.get(), _bufferSize);
 
 		initTables();
 	}
@@ -33,6 +33,7 @@
 #include "engines/wintermute/base/scriptables/dcscript.h"   // Added by ClassView
 #include "engines/wintermute/coll_templ.h"
 #include "engines/wintermute/persistent.h"
+#include "common/ptr.h"
 
 namespace Wintermute {
 class BaseScriptHolder;
@@ -132,12 +133,13 @@ public:
 	uint32 getDWORD();
 	double getFloat();
 	void cleanup();
-	bool create(const char *filename, byte *buffer, uint32 size, BaseScriptHolder *owner);
+	bool create(const char *filename, const Common::SharedPtr<byte> &buffer, uint32 size, BaseScriptHolder *owner);
 	uint32 _iP;
 private:
 	void readHeader();
 	uint32 _bufferSize;
-	byte *_buffer;
+	// Compiled bytecode, shared with the script cache and with our threads
+	Common::SharedPtr<byte> _buffer;
 public:
 	Common::SeekableReadStream *_scriptStream;
 	ScScript(BaseGame *inGame, ScEngine *engine);
@@ -33,6 +33,7 @@
 #include "engines/wintermute/base/base_game.h"
 #include "engines/wintermute/base/base_file_manager.h"
 #include "engines/wintermute/utils/utils.h"
+#include "common/algorithm.h"
 
 namespace Wintermute {
 
@@ -73,10 +74,7 @@ ScEngine::ScEngine(BaseGame *inGame) : BaseClass(inGame) {
 		_globals->setProp("Directory", &val);
 	}
 
-	// prepare script cache
-	for (int i = 0; i < MAX_CACHED_SCRIPTS; i++) {
-		_cachedScripts[i] = nullptr;
-	}
+	_cacheHits = _cacheMisses = 0;
 
 	_currentScript = nullptr;
 
@@ -140,11 +138,10 @@ void ScEngine::parseElement(void *data, int line, int type, void *elementData) {
 
 //////////////////////////////////////////////////////////////////////////
 ScScript *ScEngine::runScript(const char *filename, BaseScriptHolder *owner) {
-	byte *compBuffer;
 	uint32 compSize;
 
 	// get script from cache
-	compBuffer = getCompiledScript(filename, &compSize);
+	Common::SharedPtr<byte> compBuffer = getCompiledBuffer(filename, &compSize);
 	if (!compBuffer) {
 		return nullptr;
 	}
@@ -196,75 +193,67 @@ bool ScEngine::isRunningScript(const char *filename) {
 
 //////////////////////////////////////////////////////////////////////////
 byte *ScEngine::getCompiledScript(const char *filename, uint32 *outSize, bool ignoreCache) {
+	// the cache keeps its own reference, so the buffer stays valid until the entry is evicted
+	return getCompiledBuffer(filename, outSize, ignoreCache).get();
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+Common::SharedPtr<byte> ScEngine::getCompiledBuffer(const char *filename, uint32 *outSize, bool ignoreCache) {
 	// is script in cache?
 	if (!ignoreCache) {
-		for (int i = 0; i < MAX_CACHED_SCRIPTS; i++) {
-			if (_cachedScripts[i] && scumm_stricmp(_cachedScripts[i]->_filename.c_str(), filename) == 0) {
-				_cachedScripts[i]->_timestamp = g_system->getMillis();
-				*outSize = _cachedScripts[i]->_size;
-				return _cachedScripts[i]->_buffer;
-			}
+		ScriptCache::iterator it = _cachedScripts.find(filename);
+		if (it != _cachedScripts.end()) {
+			_cacheHits++;
+			it->_value->_timestamp = g_system->getMillis();
+			*outSize = it->_value->_size;
+			return it->_value->_buffer;
 		}
 	}
+	_cacheMisses++;
 
 	// nope, load it
-	byte *compBuffer;
-	uint32 compSize;
-
 	uint32 size;
 
 	byte *buffer = BaseEngine::instance().getFileManager()->readWholeFile(filename, &size);
 	if (!buffer) {
 		_gameRef->LOG(0, "ScEngine::GetCompiledScript - error opening script '%s'", filename);
-		return nullptr;
+		return Common::SharedPtr<byte>();
 	}
 
 	// needs to be compiled?
-	if (FROM_LE_32(*(uint32 *)buffer) == SCRIPT_MAGIC) {
-		compBuffer = buffer;
-		compSize = size;
-	} else {
+	if (FROM_LE_32(*(uint32 *)buffer) != SCRIPT_MAGIC) {
 		if (!_compilerAvailable) {
 			_gameRef->LOG(0, "ScEngine::GetCompiledScript - script '%s' needs to be compiled but compiler is not available", filename);
 			delete[] buffer;
-			return nullptr;
+			return Common::SharedPtr<byte>();
 		}
 		// This code will never be called, since _compilerAvailable is const false.
 		// It's only here in the event someone would want to reinclude the compiler.
 		error("Script needs compilation, ScummVM does not contain a WME compiler");
 	}
 
-	byte *ret = nullptr;
-
-	// add script to cache
-	CScCachedScript *cachedScript = new CScCachedScript(filename, compBuffer, compSize);
-	if (cachedScript) {
-		int index = 0;
-		uint32 minTime = g_system->getMillis();
-		for (int i = 0; i < MAX_CACHED_SCRIPTS; i++) {
-			if (_cachedScripts[i] == nullptr) {
-				index = i;
-				break;
-			} else if (_cachedScripts[i]->_timestamp <= minTime) {
-				minTime = _cachedScripts[i]->_timestamp;
-				index = i;
-			}
-		}
+	// the cache takes over the file buffer, no copy needed
+	Common::SharedPtr<byte> compBuffer(buffer, ScBufferDeleter());
 
-		if (_cachedScripts[index] != nullptr) {
-			delete _cachedScripts[index];
+	// add script to cache, replacing the least recently used one if it is full
+	ScriptCache::iterator it = _cachedScripts.find(filename);
+	if (it == _cachedScripts.end() && _cachedScripts.size() >= MAX_CACHED_SCRIPTS) {
+		it = _cachedScripts.begin();
+		for (ScriptCache::iterator i = _cachedScripts.begin(); i != _cachedScripts.end(); ++i) {
+			if (i->_value->_timestamp < it->_value->_timestamp) {
+				it = i;
+			}
 		}
-		_cachedScripts[index] = cachedScript;
-
-		ret = cachedScript->_buffer;
-		*outSize = cachedScript->_size;
 	}
+	if (it != _cachedScripts.end()) {
+		delete it->_value;
+		_cachedScripts.erase(it);
+	}
+	_cachedScripts[filename] = new CScCachedScript(filename, compBuffer, size);
 
-
-	// cleanup
-	delete[] buffer;
-
-	return ret;
+	*outSize = size;
+	return compBuffer;
 }
 
 
@@ -351,12 +340,14 @@ bool ScEngine::tick() {
 		// time sliced script
 		if (_scripts[i]->_timeSlice > 0) {
 			uint32 startTime = g_system->getMillis();
+			uint32 numInstructions = 0;
 			while (_scripts[i]->_state == SCRIPT_RUNNING && g_system->getMillis() - startTime < _scripts[i]->_timeSlice) {
 				_currentScript = _scripts[i];
 				_scripts[i]->executeInstruction();
+				numInstructions++;
 			}
 			if (_isProfiling && _scripts[i]->_filename) {
-				addScriptTime(_scripts[i]->_filename, g_system->getMillis() - startTime);
+				addScriptTime(_scripts[i]->_filename, g_system->getMillis() - startTime, numInstructions);
 			}
 		}
 
@@ -368,12 +359,14 @@ bool ScEngine::tick() {
 				startTime = g_system->getMillis();
 			}
 
+			uint32 numInstructions = 0;
 			while (_scripts[i]->_state == SCRIPT_RUNNING) {
 				_currentScript = _scripts[i];
 				_scripts[i]->executeInstruction();
+				numInstructions++;
 			}
 			if (isProfiling && _scripts[i]->_filename) {
-				addScriptTime(_scripts[i]->_filename, g_system->getMillis() - startTime);
+				addScriptTime(_scripts[i]->_filename, g_system->getMillis() - startTime, numInstructions);
 			}
 		}
 		_currentScript = nullptr;
@@ -479,12 +472,10 @@ int ScEngine::getNumScripts(int *running, int *waiting, int *persistent) {
 
 //////////////////////////////////////////////////////////////////////////
 bool ScEngine::emptyScriptCache() {
-	for (int i = 0; i < MAX_CACHED_SCRIPTS; i++) {
-		if (_cachedScripts[i]) {
-			delete _cachedScripts[i];
-			_cachedScripts[i] = nullptr;
-		}
+	for (ScriptCache::iterator it = _cachedScripts.begin(); it != _cachedScripts.end(); ++it) {
+		delete it->_value;
 	}
+	_cachedScripts.clear();
 	return STATUS_OK;
 }
 
@@ -582,14 +573,18 @@ bool ScEngine::clearGlobals(bool includingNatives) {
 }
 
 //////////////////////////////////////////////////////////////////////////
-void ScEngine::addScriptTime(const char *filename, uint32 time) {
+void ScEngine::addScriptTime(const char *filename, uint32 time, uint32 instructions) {
 	if (!_isProfiling) {
 		return;
 	}
 
 	AnsiString fileName = filename;
 	fileName.toLowercase();
-	_scriptTimes[fileName] += time;
+
+	ScriptProfile &profile = _scriptTimes[fileName];
+	profile._filename = fileName;
+	profile._time += time;
+	profile._instructions += instructions;
 }
 
 
@@ -619,28 +614,52 @@ void ScEngine::disableProfiling() {
 
 
 //////////////////////////////////////////////////////////////////////////
-void ScEngine::dumpStats() {
-	error("DumpStats not ported to ScummVM yet");
-	/*  uint32 totalTime = g_system->getMillis() - _profilingStartTime;
+static bool compareProfiles(const ScEngine::ScriptProfile &a, const ScEngine::ScriptProfile &b) {
+	if (a._time != b._time) {
+		return a._time > b._time;
+	}
+	return a._instructions > b._instructions;
+}
 
-	    typedef std::vector <std::pair<uint32, std::string> > TimeVector;
-	    TimeVector times;
+Common::Array<ScEngine::ScriptProfile> ScEngine::getProfile(uint32 *totalTime) const {
+	if (totalTime) {
+		*totalTime = _isProfiling ? g_system->getMillis() - _profilingStartTime : 0;
+	}
 
-	    ScriptTimes::iterator it;
-	    for (it = _scriptTimes.begin(); it != _scriptTimes.end(); ++it) {
-	        times.push_back(std::pair<uint32, std::string> (it->_value, it->_key));
-	    }
-	    std::sort(times.begin(), times.end());
+	Common::Array<ScriptProfile> profile;
+	for (ScriptTimes::const_iterator it = _scriptTimes.begin(); it != _scriptTimes.end(); ++it) {
+		profile.push_back(it->_value);
+	}
+	Common::sort(profile.begin(), profile.end(), compareProfiles);
 
+	return profile;
+}
 
-	    TimeVector::reverse_iterator tit;
 
-	    _gameRef->LOG(0, "***** Script profiling information: *****");
-	    _gameRef->LOG(0, "  %-40s %fs", "Total execution time", (float)totalTime / 1000);
+//////////////////////////////////////////////////////////////////////////
+void ScEngine::getCacheStats(uint32 *numCached, uint32 *hits, uint32 *misses) const {
+	*numCached = _cachedScripts.size();
+	*hits = _cacheHits;
+	*misses = _cacheMisses;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+void ScEngine::dumpStats() {
+	uint32 totalTime;
+	Common::Array<ScriptProfile> profile = getProfile(&totalTime);
+
+	_gameRef->LOG(0, "***** Script profiling information: *****");
+	_gameRef->LOG(0, "  %-40s %fs", "Total execution time", (float)totalTime / 1000);
+
+	for (uint i = 0; i < profile.size(); i++) {
+		_gameRef->LOG(0, "  %-40s %fs (%f%%) %u instructions", profile[i]._filename.c_str(), (float)profile[i]._time / 1000,
+		              totalTime ? (float)profile[i]._time / (float)totalTime * 100 : 0.0f, profile[i]._instructions);
+	}
 
-	    for (tit = times.rbegin(); tit != times.rend(); ++tit) {
-	        _gameRef->LOG(0, "  %-40s %fs (%f%%)", tit->second.c_str(), (float)tit->first / 1000, (float)tit->first / (float)totalTime * 100);
-	    }*/
+	uint32 numCached, hits, misses;
+	getCacheStats(&numCached, &hits, &misses);
+	_gameRef->LOG(0, "  Script cache: %u scripts, %u hits, %u misses", numCached, hits, misses);
 }
 
 } // End of namespace Wintermute
@@ -31,10 +31,20 @@
 #include "engines/wintermute/persistent.h"
 #include "engines/wintermute/coll_templ.h"
 #include "engines/wintermute/base/base.h"
+#include "common/hash-str.h"
+#include "common/ptr.h"
 
 namespace Wintermute {
 
-#define MAX_CACHED_SCRIPTS 20
+#define MAX_CACHED_SCRIPTS 128
+
+/** Frees compiled script buffers, which are allocated with new[] */
+struct ScBufferDeleter {
+	void operator()(byte *ptr) {
+		delete[] ptr;
+	}
+};
+
 class ScScript;
 class ScValue;
 class BaseObject;
@@ -43,28 +53,26 @@ class ScEngine : public BaseClass {
 public:
 	class CScCachedScript {
 	public:
-		CScCachedScript(const char *filename, byte *buffer, uint32 size) {
+		CScCachedScript(const char *filename, const Common::SharedPtr<byte> &buffer, uint32 size) :
+			_buffer(buffer), _size(size), _filename(filename) {
 			_timestamp = g_system->getMillis();
-			_buffer = new byte[size];
-			if (_buffer) {
-				memcpy(_buffer, buffer, size);
-			}
-			_size = size;
-			_filename = filename;
-		};
-
-		~CScCachedScript() {
-			if (_buffer) {
-				delete[] _buffer;
-			}
 		};
 
 		uint32 _timestamp;
-		byte *_buffer;
+		// Shared with every script running this file, so eviction never invalidates them
+		Common::SharedPtr<byte> _buffer;
 		uint32 _size;
 		Common::String _filename;
 	};
 
+	struct ScriptProfile {
+		ScriptProfile() : _time(0), _instructions(0) {}
+
+		Common::String _filename;
+		uint32 _time;
+		uint32 _instructions;
+	};
+
 public:
 	bool clearGlobals(bool includingNatives = false);
 	bool tickUnbreakable();
@@ -79,6 +87,7 @@ public:
 	bool resetScript(ScScript *script);
 	bool emptyScriptCache();
 	byte *getCompiledScript(const char *filename, uint32 *outSize, bool ignoreCache = false);
+	Common::SharedPtr<byte> getCompiledBuffer(const char *filename, uint32 *outSize, bool ignoreCache = false);
 	DECLARE_PERSISTENT(ScEngine, BaseClass)
 	bool cleanup();
 	int getNumScripts(int *running = nullptr, int *waiting = nullptr, int *persistent = nullptr);
@@ -102,16 +111,22 @@ public:
 		return _isProfiling;
 	}
 
-	void addScriptTime(const char *filename, uint32 Time);
+	void addScriptTime(const char *filename, uint32 time, uint32 instructions);
 	void dumpStats();
+	/** Return the profiled scripts, most expensive first */
+	Common::Array<ScriptProfile> getProfile(uint32 *totalTime) const;
+	void getCacheStats(uint32 *numCached, uint32 *hits, uint32 *misses) const;
 
 private:
+	typedef Common::HashMap<Common::String, CScCachedScript *, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> ScriptCache;
+	ScriptCache _cachedScripts;
+	uint32 _cacheHits;
+	uint32 _cacheMisses;
 
-	CScCachedScript *_cachedScripts[MAX_CACHED_SCRIPTS];
 	bool _isProfiling;
 	uint32 _profilingStartTime;
 
-	typedef Common::HashMap<Common::String, uint32> ScriptTimes;
+	typedef Common::HashMap<Common::String, ScriptProfile> ScriptTimes;
 	ScriptTimes _scriptTimes;
 
 };
@@ -22,6 +22,9 @@
 #include "engines/wintermute/debugger.h"
 #include "engines/wintermute/base/base_engine.h"
 #include "engines/wintermute/base/base_file_manager.h"
+#include "engines/wintermute/base/base_game.h"
+#include "engines/wintermute/base/base_surface_storage.h"
+#include "engines/wintermute/base/scriptables/script_engine.h"
 #include "engines/wintermute/base/scriptables/script_value.h"
 #include "engines/wintermute/debugger/debugger_controller.h"
 #include "engines/wintermute/wintermute.h"
@@ -36,6 +39,8 @@ Console::Console(WintermuteEngine *vm) : GUI::Debugger(), _engineRef(vm) {
 	registerCmd("show_fps", WRAP_METHOD(Console, Cmd_ShowFps));
 	registerCmd("dump_file", WRAP_METHOD(Console, Cmd_DumpFile));
 	registerCmd("help", WRAP_METHOD(Console, Cmd_Help));
+	registerCmd(PROFILE_CMD, WRAP_METHOD(Console, Cmd_Profile));
+	registerCmd(SURFACES_CMD, WRAP_METHOD(Console, Cmd_Surfaces));
 	// Actual (script) debugger commands
 	registerCmd(STEP_CMD, WRAP_METHOD(Console, Cmd_Step));
 	registerCmd(CONTINUE_CMD, WRAP_METHOD(Console, Cmd_Continue));
@@ -307,6 +312,63 @@ bool Console::Cmd_ShowFps(int argc, const char **argv) {
 	return true;
 }
 
+bool Console::Cmd_Profile(int argc, const char **argv) {
+	ScEngine *scEngine = _engineRef->_game ? _engineRef->_game->_scEngine : nullptr;
+	if (!scEngine) {
+		debugPrintf("%s: no game running\n", argv[0]);
+		return true;
+	}
+
+	Common::String arg = argc == 2 ? argv[1] : "";
+	if (arg == "on") {
+		scEngine->enableProfiling();
+	} else if (arg == "off") {
+		// Also writes the stats to the log
+		scEngine->disableProfiling();
+	} else if (arg == "show") {
+		uint32 totalTime;
+		Common::Array<ScEngine::ScriptProfile> profile = scEngine->getProfile(&totalTime);
+		debugPrintf("Profiling for %ums%s\n", totalTime, scEngine->getIsProfiling() ? "" : " (stopped)");
+		for (uint i = 0; i < profile.size(); i++) {
+			debugPrintf("%6ums %10u instr  %s\n", profile[i]._time, profile[i]._instructions, profile[i]._filename.c_str());
+		}
+
+		uint32 numCached, hits, misses;
+		scEngine->getCacheStats(&numCached, &hits, &misses);
+		debugPrintf("Script cache: %u/%d scripts, %u hits, %u misses\n", numCached, MAX_CACHED_SCRIPTS, hits, misses);
+	} else {
+		debugPrintf("Usage: %s [on|off|show]\n", argv[0]);
+	}
+	return true;
+}
+
+bool Console::Cmd_Surfaces(int argc, const char **argv) {
+	BaseSurfaceStorage *storage = _engineRef->_game ? _engineRef->_game->_surfaceStorage : nullptr;
+	if (!storage) {
+		debugPrintf("%s: no game running\n", argv[0]);
+		return true;
+	}
+
+	if (argc == 3 && Common::String(argv[1]) == "budget") {
+		storage->setBudget(atoi(argv[2]));
+	} else if (argc != 1) {
+		debugPrintf("Usage: %s [budget <megabytes>]\n", argv[0]);
+		return true;
+	}
+
+	BaseSurfaceStorage::Stats stats;
+	storage->getStats(&stats);
+	debugPrintf("Surfaces: %u, %u decoded\n", stats.numSurfaces, stats.numLoaded);
+	debugPrintf("Decoded: %uKB, peak %uKB, budget ", stats.loadedBytes / 1024, stats.peakBytes / 1024);
+	if (stats.budget) {
+		debugPrintf("%uKB\n", stats.budget / 1024);
+	} else {
+		debugPrintf("none\n");
+	}
+	debugPrintf("Lookups: %u hits, %u misses, %u evictions\n", stats.hits, stats.misses, stats.evictions);
+	return true;
+}
+
 bool Console::Cmd_DumpFile(int argc, const char **argv) {
 	if (argc != 3) {
 		debugPrintf("Usage: %s <file path> <output file name>\n", argv[0]);
@@ -52,6 +52,8 @@
 #define PRINT_CMD "print"
 #define SET_PATH_CMD "set_path"
 #define TOP_CMD "top"
+#define PROFILE_CMD "profile"
+#define SURFACES_CMD "surfaces"
 
 namespace Wintermute {
 class WintermuteEngine;
@@ -69,6 +71,15 @@ public:
 	bool Cmd_Help(int argc, const char **argv);
 	bool Cmd_ShowFps(int argc, const char **argv);
 	bool Cmd_DumpFile(int argc, const char **argv);
+	/**
+	 * Start or stop script profiling, or print the times and
+	 * instruction counts gathered so far
+	 */
+	bool Cmd_Profile(int argc, const char **argv);
+	/**
+	 * Print surface cache statistics, or change its budget
+	 */
+	bool Cmd_Surfaces(int argc, const char **argv);
 
 #if EXTENDED_DEBUGGER_ENABLED
 	/**
@@ -22,6 +22,7 @@
 #ifndef GRAPHICS_MACGUI_MACWINDOW_H
 #define GRAPHICS_MACGUI_MACWINDOW_H
 
+#include "common/region.h"
 #include "common/stream.h"
 
 #include "graphics/managed_surface.h"
@@ -341,7 +342,6 @@ public:
 
 	void addDirtyRect(const Common::Rect &r);
 	void markAllDirty();
-	void mergeDirtyRects();
 
 	bool isDirty() override { return _borderIsDirty || _contentIsDirty; }
 
@@ -374,7 +374,7 @@ protected:
 	bool _borderIsDirty;
 	Common::Rect _innerDims;
 
-	Common::List<Common::Rect> _dirtyRects;
+	Common::Region _dirtyRegion;
 	bool _hasScrollBar;
 
 	uint32 _mode;
@@ -0,0 +1,126 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/region.h"
+
+class RegionTestSuite : public CxxTest::TestSuite
+{
+	public:
+	void test_empty() {
+		Common::Region r;
+		TS_ASSERT(r.isEmpty());
+		TS_ASSERT_EQUALS(r.getArea(), (uint32)0);
+
+		r.unite(Common::Rect(5, 5, 5, 10));
+		TS_ASSERT(r.isEmpty());
+
+		r.unite(Common::Rect(0, 0, 10, 10));
+		r.subtract(Common::Rect(0, 0, 10, 10));
+		TS_ASSERT(r.isEmpty());
+	}
+
+	void test_unite_overlapping() {
+		Common::Region r(Common::Rect(0, 0, 10, 10));
+		r.unite(Common::Rect(5, 5, 15, 15));
+
+		// Each pixel is only covered once
+		TS_ASSERT_EQUALS(r.getArea(), (uint32)(100 + 100 - 25));
+		TS_ASSERT_EQUALS(r.size(), (uint)3);
+		TS_ASSERT_EQUALS(r.getBounds(), Common::Rect(0, 0, 15, 15));
+
+		TS_ASSERT(r.contains(0, 0));
+		TS_ASSERT(r.contains(14, 14));
+		TS_ASSERT(!r.contains(14, 0));
+		TS_ASSERT(!r.contains(0, 14));
+	}
+
+	void test_unite_coalesces() {
+		Common::Region r(Common::Rect(0, 0, 10, 10));
+		r.unite(Common::Rect(0, 10, 10, 20));
+		TS_ASSERT_EQUALS(r.size(), (uint)1);
+		TS_ASSERT_EQUALS(*r.begin(), Common::Rect(0, 0, 10, 20));
+
+		r.unite(Common::Rect(10, 0, 20, 20));
+		TS_ASSERT_EQUALS(r.size(), (uint)1);
+		TS_ASSERT_EQUALS(*r.begin(), Common::Rect(0, 0, 20, 20));
+
+		// Fully contained rects change nothing
+		r.unite(Common::Rect(5, 5, 8, 8));
+		TS_ASSERT_EQUALS(r, Common::Region(Common::Rect(0, 0, 20, 20)));
+	}
+
+	void test_subtract() {
+		Common::Region r(Common::Rect(0, 0, 30, 30));
+		r.subtract(Common::Rect(10, 10, 20, 20));
+
+		TS_ASSERT_EQUALS(r.getArea(), (uint32)(900 - 100));
+		TS_ASSERT_EQUALS(r.size(), (uint)4);
+		TS_ASSERT(!r.contains(15, 15));
+		TS_ASSERT(r.contains(5, 15));
+		TS_ASSERT(r.contains(25, 15));
+		TS_ASSERT(!r.intersects(Common::Rect(10, 10, 20, 20)));
+		TS_ASSERT(r.intersects(Common::Rect(19, 19, 21, 21)));
+
+		// Filling the hole back gives the original rect
+		r.unite(Common::Rect(10, 10, 20, 20));
+		TS_ASSERT_EQUALS(r, Common::Region(Common::Rect(0, 0, 30, 30)));
+	}
+
+	void test_intersect() {
+		Common::Region r(Common::Rect(0, 0, 10, 10));
+		r.unite(Common::Rect(20, 0, 30, 10));
+		r.intersect(Common::Rect(5, 5, 25, 15));
+
+		TS_ASSERT_EQUALS(r.size(), (uint)2);
+		TS_ASSERT_EQUALS(r.getArea(), (uint32)50);
+		TS_ASSERT_EQUALS(r.getBounds(), Common::Rect(5, 5, 25, 10));
+
+		r.intersect(Common::Rect(40, 40, 50, 50));
+		TS_ASSERT(r.isEmpty());
+	}
+
+	void test_contains_rect() {
+		Common::Region r(Common::Rect(0, 0, 10, 10));
+		r.unite(Common::Rect(10, 5, 20, 15));
+
+		TS_ASSERT(r.contains(Common::Rect(5, 5, 15, 10)));
+		TS_ASSERT(!r.contains(Common::Rect(5, 5, 15, 12)));
+		TS_ASSERT(r.contains(Common::Rect()));
+	}
+
+	void test_order_independent() {
+		Common::Rect rects[] = {
+			Common::Rect(3, 7, 40, 12),
+			Common::Rect(0, 0, 8, 30),
+			Common::Rect(20, 2, 25, 50),
+			Common::Rect(6, 10, 22, 11),
+			Common::Rect(35, 20, 60, 25)
+		};
+
+		Common::Region a, b;
+		for (int i = 0; i < ARRAYSIZE(rects); i++) {
+			a.unite(rects[i]);
+			b.unite(rects[ARRAYSIZE(rects) - 1 - i]);
+		}
+		TS_ASSERT_EQUALS(a, b);
+
+		// Rects are banded: sorted by top, then left, never overlapping
+		for (Common::Region::const_iterator i = a.begin(); i != a.end(); ++i) {
+			for (Common::Region::const_iterator j = i + 1; j != a.end(); ++j) {
+				TS_ASSERT(!i->intersects(*j));
+				TS_ASSERT(i->top < j->top || (i->top == j->top && i->bottom == j->bottom && i->right <= j->left));
+			}
+		}
+
+		uint32 area = 0;
+		for (int y = 0; y < 60; y++) {
+			for (int x = 0; x < 70; x++) {
+				bool inside = false;
+				for (int i = 0; i < ARRAYSIZE(rects); i++)
+					inside |= rects[i].contains(x, y);
+				TS_ASSERT_EQUALS(a.contains(x, y), inside);
+				area += inside;
+			}
+		}
+		TS_ASSERT_EQUALS(a.getArea(), area);
+	}
+};
@@ -0,0 +1,90 @@
+#include <cxxtest/TestSuite.h>
+#include "engines/glk/mem_diff.h"
+/**
+ * Test suite for the functions in engines/glk/mem_diff.h
+ */
+
+class GlkMemDiffTestSuite : public CxxTest::TestSuite {
+	public:
+	GlkMemDiffTestSuite() {
+	}
+
+	// Diffs cur against prev, checks prev has been brought up to date, then
+	// applies the diff to a fresh copy of the original prev
+	void roundTrip(const byte *cur, const byte *prev, uint32 size) {
+		byte *base = new byte[size];
+		byte *copy = new byte[size];
+		byte *diff = new byte[Glk::memDiffMaxSize(size)];
+		memcpy(base, prev, size);
+		memcpy(copy, prev, size);
+
+		uint32 len = Glk::memDiff(cur, base, size, diff);
+		TS_ASSERT(len <= Glk::memDiffMaxSize(size));
+		TS_ASSERT(memcmp(base, cur, size) == 0);
+
+		Glk::memUndiff(diff, len, copy);
+		TS_ASSERT(memcmp(copy, cur, size) == 0);
+
+		// Applying it again takes the memory back where it started
+		Glk::memUndiff(diff, len, copy);
+		TS_ASSERT(memcmp(copy, prev, size) == 0);
+
+		delete[] base;
+		delete[] copy;
+		delete[] diff;
+	}
+
+	void test_identical() {
+		byte a[256], b[256], diff[512];
+		memset(a, 0x5a, sizeof(a));
+		memcpy(b, a, sizeof(b));
+		TS_ASSERT_EQUALS(Glk::memDiff(a, b, sizeof(a), diff), 0u);
+	}
+
+	void test_sparse_changes() {
+		byte a[1000], b[1000];
+		memset(b, 0, sizeof(b));
+		memcpy(a, b, sizeof(a));
+		a[0] = 1;
+		a[1] = 2;
+		a[200] = 3;
+		a[999] = 4;
+		roundTrip(a, b, sizeof(a));
+	}
+
+	void test_every_byte_changed() {
+		byte a[300], b[300];
+		for (int i = 0; i < 300; ++i) {
+			a[i] = i & 0xff;
+			b[i] = ~a[i];
+		}
+		roundTrip(a, b, sizeof(a));
+	}
+
+	void test_alternating_changes() {
+		// Worst case for the encoding: every other byte differs
+		byte a[512], b[512];
+		memset(a, 0, sizeof(a));
+		memset(b, 0, sizeof(b));
+		for (int i = 0; i < 512; i += 2)
+			a[i] = 0xff;
+		roundTrip(a, b, sizeof(a));
+	}
+
+	void test_long_runs() {
+		// Memory past 64K, with unchanged stretches longer than a single run can hold
+		const uint32 size = 200000;
+		byte *a = new byte[size];
+		byte *b = new byte[size];
+		memset(a, 0, size);
+		memset(b, 0, size);
+		a[10] = 1;
+		a[10 + 0x8000] = 2;
+		a[10 + 0x8001 + 0x8000] = 3;
+		a[150000] = 4;
+		a[size - 1] = 5;
+		roundTrip(a, b, size);
+		delete[] a;
+		delete[] b;
+	}
+};
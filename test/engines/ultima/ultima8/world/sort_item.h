@@ -127,4 +127,40 @@ class U8SortItemTestSuite : public CxxTest::TestSuite {
 		si1._fbigsq = false;
 	}
 
+	/**
+	 * Items whose screenspace bounding boxes don't intersect never overlap.
+	 * ItemSorter relies on this to only compare items sharing a bin.
+	 */
+	void test_overlap_needs_box_overlap() {
+		Ultima::Ultima8::SortItem si1(nullptr);
+		Ultima::Ultima8::SortItem si2(nullptr);
+
+		si1._sxLeft = si2._sxLeft = 0;
+		si1._sxRight = si2._sxRight = 20;
+		si1._sxTop = si2._sxTop = 10;
+		si1._sxBot = si2._sxBot = 10;
+		si1._syTop = 0;
+		si1._syBot = 20;
+
+		// Touching boxes
+		si2._syTop = 20;
+		si2._syBot = 40;
+		TS_ASSERT(!si1.overlap(si2));
+		TS_ASSERT(!si2.overlap(si1));
+
+		si2._syTop = 19;
+		si2._syBot = 39;
+		TS_ASSERT(si1.overlap(si2));
+		TS_ASSERT(si2.overlap(si1));
+
+		// Side by side
+		si2._syTop = 0;
+		si2._syBot = 20;
+		si2._sxLeft = 20;
+		si2._sxRight = 40;
+		si2._sxTop = si2._sxBot = 30;
+		TS_ASSERT(!si1.overlap(si2));
+		TS_ASSERT(!si2.overlap(si1));
+	}
+
 };